@@ -0,0 +1,700 @@
+# QMsm code generator: declarative state table -> QMState/QMTranActTable
+#
+# Usage in a CMake project (the 'cmake' directory of the QP/C SDK is added
+# to CMAKE_MODULE_PATH by qpc_sdk_init.cmake):
+#
+#   include(qpc_qmsm_gen)
+#   qpc_qmsm_generate(<target> <spec-file> [OUTPUT_DIR <dir>])
+#
+# The generator runs at build time (whenever the spec file changes) and
+# adds '<name>_qmsm.c' to the sources of <target> and the directory of
+# '<name>_qmsm.h' to its include directories, where <name> is the name of
+# the spec file without the extension. It can also be run directly:
+#
+#   cmake -DQMSM_SPEC=<spec-file> -DQMSM_OUT=<dir> -P qpc_qmsm_gen.cmake
+#
+# Spec file format (one statement per line, '#' starts a comment):
+#
+#   machine <Class>          the state machine class (a struct that starts
+#                            with a QMsm or QMActive member 'super')
+#   include <header>         header(s) declaring the class and the signals
+#   signals <SIG> ...        optional, all the signals in ascending order
+#                            (generates the signal maps for QMSM_SIG_MAP)
+#   state <name> [parent=<state>] [entry=<fn>] [exit=<fn>]
+#   initial top <target> [action=<fn>]       top-most initial tran.
+#   initial <state> <target> [action=<fn>]   initial tran. in <state>
+#   tran <state> <SIG> <target> [guard=<fn>] [action=<fn>]
+#   internal <state> <SIG> [guard=<fn>] [action=<fn>]
+#
+# The states must be declared before they are referenced as parents.
+# The application provides the following functions:
+#
+#   void <entry/exit>(<Class> * const me);
+#   void <initial action>(<Class> * const me, void const * const par); (top)
+#   void <initial action>(<Class> * const me);                   (nested)
+#   bool <guard>(<Class> * const me, QEvt const * const e);
+#   void <tran/internal action>(<Class> * const me, QEvt const * const e);
+#
+# and uses the generated <Class>_initial() as the top-most initial tran.
+# of the QMsm/QMActive constructor. The QMState objects <Class>_<state>_s
+# are public (e.g., for QMsm_isInState() or the snapshot registries).
+#
+# Transitions follow the QHsm semantics: the transitions between a state
+# and its own substate or superstate do not exit/enter the containing
+# state, while a transition to self exits and enters the state again.
+# Transitions to history are not supported.
+
+if(CMAKE_SCRIPT_MODE_FILE)
+    cmake_policy(VERSION 3.13)
+endif()
+
+#............................................................................
+function(_qmsm_error line msg)
+    message(FATAL_ERROR "${QMSM_SPEC}:${line}: ${msg}")
+endfunction()
+
+#............................................................................
+# check that 'id' is a valid C identifier
+function(_qmsm_check_id line id)
+    if(NOT id MATCHES "^[A-Za-z_][A-Za-z0-9_]*$")
+        _qmsm_error(${line} "'${id}' is not a valid C identifier")
+    endif()
+endfunction()
+
+#............................................................................
+# register the application function 'fn' with the given role (signature)
+macro(_qmsm_use_fn line fn role)
+    _qmsm_check_id(${line} ${fn})
+    if(DEFINED _fn_${fn}_role)
+        if(NOT _fn_${fn}_role STREQUAL "${role}")
+            _qmsm_error(${line}
+                "'${fn}' used as '${role}' and '${_fn_${fn}_role}'")
+        endif()
+    else()
+        set(_fn_${fn}_role ${role})
+        list(APPEND _fns ${fn})
+    endif()
+endmacro()
+
+#............................................................................
+# the path from the state 's' up to its top-level ancestor (inclusive)
+function(_qmsm_path s out)
+    set(path)
+    while(NOT s STREQUAL "")
+        list(APPEND path ${s})
+        set(s "${_st_${s}_parent}")
+    endwhile()
+    set(${out} ${path} PARENT_SCOPE)
+endfunction()
+
+#............................................................................
+# the action handlers of the tran. from 's' to 't' (see QHsm_tran_simple_)
+function(_qmsm_tran_acts s t out)
+    _qmsm_path(${s} ps)
+    _qmsm_path(${t} pt)
+    set(exits)
+    set(entries)
+    list(FIND pt ${s} is) # position of 's' in the path of 't'
+    list(FIND ps ${t} it) # position of 't' in the path of 's'
+    if(s STREQUAL t) # tran. to self
+        set(exits ${s})
+        set(entries ${t})
+    elseif(is GREATER 0) # 's' is a superstate of 't'
+        list(SUBLIST pt 0 ${is} entries)
+    elseif(it GREATER 0) # 't' is a superstate of 's'
+        list(SUBLIST ps 0 ${it} exits)
+    else() # exit up to and enter down from the LCA of 's' and 't'
+        set(lca "")
+        foreach(x IN LISTS ps)
+            list(FIND pt ${x} i)
+            if(i GREATER -1)
+                set(lca ${x})
+                break()
+            endif()
+        endforeach()
+        set(exits ${ps})
+        set(entries ${pt})
+        if(NOT lca STREQUAL "")
+            list(FIND ps ${lca} i)
+            list(SUBLIST ps 0 ${i} exits)
+            list(FIND pt ${lca} i)
+            list(SUBLIST pt 0 ${i} entries)
+        endif()
+    endif()
+    _qmsm_enter_acts(${t} "${exits}" "${entries}" acts)
+    set(${out} ${acts} PARENT_SCOPE)
+endfunction()
+
+#............................................................................
+# the exit actions of 'exits', the entry actions of 'entries' (in reverse)
+# and the initial tran. of the target 't'
+function(_qmsm_enter_acts t exits entries out)
+    set(acts)
+    foreach(x IN LISTS exits)
+        if(NOT _st_${x}_exit STREQUAL "")
+            list(APPEND acts "${_machine}_${x}_x")
+        endif()
+    endforeach()
+    list(REVERSE entries)
+    foreach(x IN LISTS entries)
+        if(NOT _st_${x}_entry STREQUAL "")
+            list(APPEND acts "${_machine}_${x}_e")
+        endif()
+    endforeach()
+    if(NOT _st_${t}_init STREQUAL "")
+        list(APPEND acts "${_machine}_${t}_i")
+    endif()
+    set(${out} ${acts} PARENT_SCOPE)
+endfunction()
+
+#............................................................................
+# append the definition of a tran-action table to the variable 'code'
+function(_qmsm_tatbl name comment t acts)
+    list(LENGTH acts n)
+    math(EXPR n "${n} + 1")
+    string(APPEND code
+        "\n// ${comment}\n"
+        "static struct {\n"
+        "    QMState const *target;\n"
+        "    QActionHandler act[${n}];\n"
+        "} const ${name} = {\n"
+        "    &${_machine}_${t}_s, // target state\n"
+        "    {\n")
+    foreach(a IN LISTS acts)
+        string(APPEND code "        Q_ACTION_CAST(&${a}),\n")
+    endforeach()
+    string(APPEND code
+        "        Q_ACTION_NULL // zero terminator\n"
+        "    }\n"
+        "};\n")
+    set(code "${code}" PARENT_SCOPE)
+endfunction()
+
+#............................................................................
+function(_qmsm_generate spec outdir)
+    set(QMSM_SPEC ${spec})
+    get_filename_component(stem ${spec} NAME_WE)
+    file(READ ${spec} text)
+    string(REGEX REPLACE "#[^\n]*" "" text "${text}") # strip the comments
+    if(text MATCHES ";")
+        message(FATAL_ERROR "${spec}: ';' is not allowed in the spec file")
+    endif()
+    string(REPLACE "\n" ";" lines "${text}")
+
+    # parse the spec file...
+    set(_machine "")
+    set(_includes)
+    set(_signals)
+    set(_states)
+    set(_trans)
+    set(_fns)
+    set(_top_init "")
+    set(ln 0)
+    foreach(l IN LISTS lines)
+        math(EXPR ln "${ln} + 1")
+        string(STRIP "${l}" l)
+        if(l STREQUAL "")
+            continue()
+        endif()
+        string(REGEX REPLACE "[ \t]+" ";" toks "${l}")
+        list(GET toks 0 kw)
+        list(REMOVE_AT toks 0)
+
+        # split the tokens into the positional arguments and the options
+        set(args)
+        foreach(opt parent entry exit action guard)
+            set(o_${opt} "")
+        endforeach()
+        foreach(tok IN LISTS toks)
+            if(tok MATCHES "^([a-z]+)=(.*)$")
+                set(key ${CMAKE_MATCH_1})
+                set(val ${CMAKE_MATCH_2})
+                if(NOT key MATCHES "^(parent|entry|exit|action|guard)$")
+                    _qmsm_error(${ln} "unknown option '${key}'")
+                endif()
+                set(o_${key} ${val})
+            else()
+                list(APPEND args ${tok})
+            endif()
+        endforeach()
+        list(LENGTH args nargs)
+
+        if((NOT kw STREQUAL "machine") AND (_machine STREQUAL ""))
+            _qmsm_error(${ln} "'machine' must be the first statement")
+        endif()
+
+        if(kw STREQUAL "machine")
+            if((NOT nargs EQUAL 1) OR (NOT _machine STREQUAL ""))
+                _qmsm_error(${ln} "expected a single 'machine <Class>'")
+            endif()
+            set(_machine ${args})
+            _qmsm_check_id(${ln} ${_machine})
+        elseif(kw STREQUAL "include")
+            if(NOT nargs EQUAL 1)
+                _qmsm_error(${ln} "expected 'include <header>'")
+            endif()
+            if(NOT args MATCHES "^[<\"]")
+                set(args "\"${args}\"")
+            endif()
+            list(APPEND _includes ${args})
+        elseif(kw STREQUAL "signals")
+            foreach(sig IN LISTS args)
+                _qmsm_check_id(${ln} ${sig})
+                list(APPEND _signals ${sig})
+            endforeach()
+        elseif(kw STREQUAL "state")
+            if(NOT nargs EQUAL 1)
+                _qmsm_error(${ln} "expected 'state <name> [options]'")
+            endif()
+            set(s ${args})
+            _qmsm_check_id(${ln} ${s})
+            list(FIND _states ${s} i)
+            if((i GREATER -1) OR (s STREQUAL "top"))
+                _qmsm_error(${ln} "state '${s}' already defined")
+            endif()
+            if(NOT o_parent STREQUAL "")
+                list(FIND _states ${o_parent} i)
+                if(i EQUAL -1)
+                    _qmsm_error(${ln} "undefined parent state '${o_parent}'")
+                endif()
+            endif()
+            list(APPEND _states ${s})
+            set(_st_${s}_parent "${o_parent}")
+            set(_st_${s}_entry "${o_entry}")
+            set(_st_${s}_exit "${o_exit}")
+            set(_st_${s}_init "")
+            set(_st_${s}_sigs)
+            if(NOT o_entry STREQUAL "")
+                _qmsm_use_fn(${ln} ${o_entry} "entry/exit")
+            endif()
+            if(NOT o_exit STREQUAL "")
+                _qmsm_use_fn(${ln} ${o_exit} "entry/exit")
+            endif()
+        elseif(kw STREQUAL "initial")
+            if(NOT nargs EQUAL 2)
+                _qmsm_error(${ln} "expected 'initial <state> <target>'")
+            endif()
+            list(GET args 0 s)
+            list(GET args 1 t)
+            list(FIND _states ${t} i)
+            if(i EQUAL -1)
+                _qmsm_error(${ln} "undefined target state '${t}'")
+            endif()
+            if(s STREQUAL "top")
+                if(NOT _top_init STREQUAL "")
+                    _qmsm_error(${ln} "duplicate top-most initial tran.")
+                endif()
+                set(_top_init ${t})
+                set(_top_initact "${o_action}")
+                if(NOT o_action STREQUAL "")
+                    _qmsm_use_fn(${ln} ${o_action} "top initial action")
+                endif()
+            else()
+                list(FIND _states ${s} i)
+                if(i EQUAL -1)
+                    _qmsm_error(${ln} "undefined state '${s}'")
+                endif()
+                if(NOT _st_${s}_init STREQUAL "")
+                    _qmsm_error(${ln} "duplicate initial tran. in '${s}'")
+                endif()
+                _qmsm_path(${t} pt)
+                list(FIND pt ${s} i)
+                if(i LESS 1)
+                    _qmsm_error(${ln} "'${t}' is not a substate of '${s}'")
+                endif()
+                set(_st_${s}_init ${t})
+                set(_st_${s}_initact "${o_action}")
+                if(NOT o_action STREQUAL "")
+                    _qmsm_use_fn(${ln} ${o_action} "initial action")
+                endif()
+            endif()
+        elseif((kw STREQUAL "tran") OR (kw STREQUAL "internal"))
+            if(kw STREQUAL "tran")
+                set(n 3)
+            else()
+                set(n 2)
+            endif()
+            if(NOT nargs EQUAL n)
+                _qmsm_error(${ln} "wrong number of arguments of '${kw}'")
+            endif()
+            list(GET args 0 s)
+            list(GET args 1 sig)
+            set(t "")
+            if(kw STREQUAL "tran")
+                list(GET args 2 t)
+                list(FIND _states ${t} i)
+                if(i EQUAL -1)
+                    _qmsm_error(${ln} "undefined target state '${t}'")
+                endif()
+            endif()
+            list(FIND _states ${s} i)
+            if(i EQUAL -1)
+                _qmsm_error(${ln} "undefined state '${s}'")
+            endif()
+            _qmsm_check_id(${ln} ${sig})
+            if(NOT o_guard STREQUAL "")
+                _qmsm_use_fn(${ln} ${o_guard} "guard")
+            endif()
+            if(NOT o_action STREQUAL "")
+                _qmsm_use_fn(${ln} ${o_action} "action")
+            endif()
+
+            # the alternatives for the same signal are checked in order
+            foreach(k IN LISTS _st_${s}_${sig}_trs)
+                if(_tr_${k}_guard STREQUAL "")
+                    _qmsm_error(${ln} "'${sig}' in '${s}' unreachable after line ${k}")
+                endif()
+            endforeach()
+            list(APPEND _trans ${ln})
+            set(_tr_${ln}_src ${s})
+            set(_tr_${ln}_sig ${sig})
+            set(_tr_${ln}_tgt "${t}")
+            set(_tr_${ln}_guard "${o_guard}")
+            set(_tr_${ln}_act "${o_action}")
+            if(NOT DEFINED _st_${s}_${sig}_trs)
+                list(APPEND _st_${s}_sigs ${sig})
+            endif()
+            list(APPEND _st_${s}_${sig}_trs ${ln})
+        else()
+            _qmsm_error(${ln} "unknown statement '${kw}'")
+        endif()
+    endforeach()
+
+    if(_machine STREQUAL "")
+        message(FATAL_ERROR "${spec}: no 'machine' statement")
+    endif()
+    if(_top_init STREQUAL "")
+        message(FATAL_ERROR "${spec}: no top-most initial tran.")
+    endif()
+
+    # the signal maps need the order of all signals...
+    set(useMap FALSE)
+    if(_signals)
+        set(useMap TRUE)
+        foreach(k IN LISTS _trans)
+            list(FIND _signals ${_tr_${k}_sig} i)
+            if(i EQUAL -1)
+                _qmsm_error(${k} "'${_tr_${k}_sig}' not listed in 'signals'")
+            endif()
+        endforeach()
+    endif()
+
+    set(M ${_machine})
+    set(note "generated by qpc_qmsm_gen.cmake from ${stem} -- DO NOT EDIT")
+
+    # generate the header...
+    string(TOUPPER "${stem}_QMSM_H_" hguard)
+    string(REGEX REPLACE "[^A-Z0-9_]" "_" hguard "${hguard}")
+    set(hdr "//${note}\n#ifndef ${hguard}\n#define ${hguard}\n\n")
+    foreach(inc IN LISTS _includes)
+        string(APPEND hdr "#include ${inc}\n")
+    endforeach()
+    string(APPEND hdr
+        "\n// the top-most initial tran. (see QMsm_ctor()/QMActive_ctor())\n"
+        "QState ${M}_initial(${M} * const me, void const * const par);\n\n"
+        "// the states of ${M}\n")
+    foreach(s IN LISTS _states)
+        string(APPEND hdr "extern QMState const ${M}_${s}_s;\n")
+    endforeach()
+    string(APPEND hdr "\n#endif // ${hguard}\n")
+
+    # generate the source...
+    set(code "//${note}\n")
+    string(APPEND code "#include \"qpc.h\"\n#include \"${stem}_qmsm.h\"\n")
+
+    # application functions
+    string(APPEND code "\n// application functions used in ${M}\n")
+    foreach(fn IN LISTS _fns)
+        set(role "${_fn_${fn}_role}")
+        if(role STREQUAL "entry/exit")
+            set(par "")
+            set(ret void)
+        elseif(role STREQUAL "top initial action")
+            set(par ",\n    void const * const par")
+            set(ret void)
+        elseif(role STREQUAL "initial action")
+            set(par "")
+            set(ret void)
+        elseif(role STREQUAL "guard")
+            set(par ",\n    QEvt const * const e")
+            set(ret bool)
+        else()
+            set(par ",\n    QEvt const * const e")
+            set(ret void)
+        endif()
+        string(APPEND code "${ret} ${fn}(${M} * const me${par});\n")
+    endforeach()
+
+    # state handlers and action handlers
+    string(APPEND code "\n//${M} state handlers and action handlers\n")
+    foreach(s IN LISTS _states)
+        string(APPEND code "static QState ${M}_${s}(${M} * const me,\n"
+                           "    QEvt const * const e);\n")
+        foreach(kind entry exit init)
+            if(NOT _st_${s}_${kind} STREQUAL "")
+                string(SUBSTRING ${kind} 0 1 k)
+                if(kind STREQUAL "exit")
+                    set(k x)
+                endif()
+                string(APPEND code
+                    "static QState ${M}_${s}_${k}(${M} * const me);\n")
+            endif()
+        endforeach()
+    endforeach()
+
+    # tran-action tables...
+    string(APPEND code "\n//${M} tran-action tables\n")
+    _qmsm_path(${_top_init} pt)
+    _qmsm_enter_acts(${_top_init} "" "${pt}" acts)
+    _qmsm_tatbl(${M}_initial_tatbl_ "top-most initial tran. -> ${_top_init}"
+        ${_top_init} "${acts}")
+    foreach(s IN LISTS _states)
+        set(t "${_st_${s}_init}")
+        if(NOT t STREQUAL "")
+            _qmsm_path(${t} pt)
+            list(FIND pt ${s} i)
+            list(SUBLIST pt 0 ${i} pt)
+            _qmsm_enter_acts(${t} "" "${pt}" acts)
+            _qmsm_tatbl(${M}_${s}_init_tatbl_ "${s}: initial tran. -> ${t}"
+                ${t} "${acts}")
+        endif()
+    endforeach()
+    foreach(k IN LISTS _trans)
+        if(NOT _tr_${k}_tgt STREQUAL "")
+            set(s ${_tr_${k}_src})
+            set(t ${_tr_${k}_tgt})
+            _qmsm_tran_acts(${s} ${t} acts)
+            _qmsm_tatbl(${M}_${s}_tatbl${k}_
+                "${s}: ${_tr_${k}_sig} -> ${t} (line ${k})" ${t} "${acts}")
+        endif()
+    endforeach()
+
+    # signal maps, see QMSM_SIG_MAP
+    if(useMap)
+        string(APPEND code "\n#ifdef QMSM_SIG_MAP\n")
+        foreach(s IN LISTS _states)
+            string(APPEND code "static QMSigAct const ${M}_${s}_map_[] = {\n")
+            foreach(sig IN LISTS _signals)
+                list(FIND _st_${s}_sigs ${sig} i)
+                if(i GREATER -1)
+                    set(trs ${_st_${s}_${sig}_trs})
+                    list(GET trs 0 k)
+                    list(LENGTH trs n)
+                    # unconditional tran. without actions taken from the map
+                    if((n EQUAL 1) AND (NOT _tr_${k}_tgt STREQUAL "")
+                        AND (_tr_${k}_guard STREQUAL "")
+                        AND (_tr_${k}_act STREQUAL ""))
+                        set(tt "(struct QMTranActTable const *)&${M}_${s}_tatbl${k}_")
+                    else()
+                        set(tt "(struct QMTranActTable const *)0")
+                    endif()
+                    string(APPEND code "    { (QSignal)${sig}, ${tt} },\n")
+                endif()
+            endforeach()
+            string(APPEND code "    QM_SIG_MAP_END\n};\n")
+        endforeach()
+        string(APPEND code "#endif // def QMSM_SIG_MAP\n")
+    endif()
+
+    # QMState objects...
+    set(index 0)
+    foreach(s IN LISTS _states)
+        set(p "${_st_${s}_parent}")
+        set(sup QM_STATE_NULL)
+        if(NOT p STREQUAL "")
+            set(sup "&${M}_${p}_s")
+        endif()
+        set(c_entry Q_ACTION_NULL)
+        set(c_exit Q_ACTION_NULL)
+        set(c_init Q_ACTION_NULL)
+        if(NOT _st_${s}_entry STREQUAL "")
+            set(c_entry "Q_ACTION_CAST(&${M}_${s}_e)")
+        endif()
+        if(NOT _st_${s}_exit STREQUAL "")
+            set(c_exit "Q_ACTION_CAST(&${M}_${s}_x)")
+        endif()
+        if(NOT _st_${s}_init STREQUAL "")
+            set(c_init "Q_ACTION_CAST(&${M}_${s}_i)")
+        endif()
+        string(APPEND code
+            "\n//${M}::${s}\n"
+            "QMState const ${M}_${s}_s = {\n"
+            "    ${sup}, // superstate\n"
+            "    Q_STATE_CAST(&${M}_${s}),\n"
+            "    ${c_entry},\n"
+            "    ${c_exit},\n"
+            "    ${c_init}\n"
+            "#ifdef QMSM_SIG_MAP\n")
+        if(useMap)
+            string(APPEND code "    , &${M}_${s}_map_[0]\n")
+        else()
+            string(APPEND code "    , QM_SIG_MAP_NULL\n")
+        endif()
+        string(APPEND code "#endif\n#ifdef QASM_ANCESTRY\n")
+
+        # ancestry bitset & index (the parents are indexed first), see
+        # NOTE2 in qep_msm.c
+        set(_st_${s}_index 255)
+        set(_st_${s}_anc 0)
+        if((index LESS 32) AND
+            ((p STREQUAL "") OR (_st_${p}_index LESS 255)))
+            set(_st_${s}_index ${index})
+            set(anc 0)
+            if(NOT p STREQUAL "")
+                set(anc ${_st_${p}_anc})
+            endif()
+            math(EXPR _st_${s}_anc "${anc} | (1 << ${index})")
+            math(EXPR index "${index} + 1")
+        endif()
+        math(EXPR hex "${_st_${s}_anc}" OUTPUT_FORMAT HEXADECIMAL)
+        string(APPEND code "    , ${hex}U, ${_st_${s}_index}U\n#endif\n};\n")
+    endforeach()
+
+    # action handlers and state handlers...
+    string(APPEND code
+        "\n//${M}::SM\n"
+        "QState ${M}_initial(${M} * const me, void const * const par) {\n")
+    if(_top_initact STREQUAL "")
+        string(APPEND code "    Q_UNUSED_PAR(par);\n")
+    else()
+        string(APPEND code "    ${_top_initact}(me, par);\n")
+    endif()
+    string(APPEND code
+        "    return QM_TRAN_INIT(&${M}_initial_tatbl_);\n}\n")
+
+    foreach(s IN LISTS _states)
+        string(APPEND code "\n//${M}::${s}\n")
+        if(NOT _st_${s}_entry STREQUAL "")
+            string(APPEND code
+                "static QState ${M}_${s}_e(${M} * const me) {\n"
+                "    ${_st_${s}_entry}(me);\n"
+                "    return QM_ENTRY(&${M}_${s}_s);\n}\n")
+        endif()
+        if(NOT _st_${s}_exit STREQUAL "")
+            string(APPEND code
+                "static QState ${M}_${s}_x(${M} * const me) {\n"
+                "    ${_st_${s}_exit}(me);\n"
+                "    return QM_EXIT(&${M}_${s}_s);\n}\n")
+        endif()
+        if(NOT _st_${s}_init STREQUAL "")
+            string(APPEND code "static QState ${M}_${s}_i(${M} * const me) {\n")
+            if(NOT _st_${s}_initact STREQUAL "")
+                string(APPEND code "    ${_st_${s}_initact}(me);\n")
+            else()
+                string(APPEND code "    Q_UNUSED_PAR(me);\n")
+            endif()
+            string(APPEND code
+                "    return QM_TRAN_INIT(&${M}_${s}_init_tatbl_);\n}\n")
+        endif()
+
+        string(APPEND code "static QState ${M}_${s}(${M} * const me,\n"
+                           "    QEvt const * const e)\n{\n")
+        if(NOT _st_${s}_sigs)
+            string(APPEND code
+                "    Q_UNUSED_PAR(me);\n"
+                "    Q_UNUSED_PAR(e);\n"
+                "    return QM_SUPER();\n}\n")
+            continue()
+        endif()
+
+        # 'me' is used by the guards, the actions and QM_TRAN()
+        set(usesMe FALSE)
+        foreach(sig IN LISTS _st_${s}_sigs)
+            foreach(k IN LISTS _st_${s}_${sig}_trs)
+                if((NOT _tr_${k}_tgt STREQUAL "")
+                    OR (NOT _tr_${k}_guard STREQUAL "")
+                    OR (NOT _tr_${k}_act STREQUAL ""))
+                    set(usesMe TRUE)
+                endif()
+            endforeach()
+        endforeach()
+        if(NOT usesMe)
+            string(APPEND code "    Q_UNUSED_PAR(me);\n")
+        endif()
+
+        string(APPEND code "    QState status_;\n    switch (e->sig) {\n")
+        foreach(sig IN LISTS _st_${s}_sigs)
+            string(APPEND code "        case ${sig}: {\n")
+            set(trs ${_st_${s}_${sig}_trs})
+            set(ind "            ")
+            set(first TRUE)
+            set(open FALSE) # an 'if' chain is open?
+            foreach(k IN LISTS trs)
+                set(g "${_tr_${k}_guard}")
+                if(NOT g STREQUAL "")
+                    if(first)
+                        string(APPEND code "${ind}if (${g}(me, e)) {\n")
+                    else()
+                        string(APPEND code "${ind}else if (${g}(me, e)) {\n")
+                    endif()
+                    set(open TRUE)
+                    set(bi "${ind}    ")
+                elseif(open)
+                    string(APPEND code "${ind}else {\n")
+                    set(bi "${ind}    ")
+                else()
+                    set(bi "${ind}")
+                endif()
+                if(NOT _tr_${k}_act STREQUAL "")
+                    string(APPEND code "${bi}${_tr_${k}_act}(me, e);\n")
+                endif()
+                if(_tr_${k}_tgt STREQUAL "")
+                    string(APPEND code "${bi}status_ = QM_HANDLED();\n")
+                else()
+                    string(APPEND code
+                        "${bi}status_ = QM_TRAN(&${M}_${s}_tatbl${k}_);\n")
+                endif()
+                if(open)
+                    string(APPEND code "${ind}}\n")
+                endif()
+                set(first FALSE)
+                set(lastGuard "${g}")
+            endforeach()
+            if(NOT lastGuard STREQUAL "")
+                string(APPEND code "${ind}else {\n"
+                    "${ind}    status_ = QM_UNHANDLED();\n${ind}}\n")
+            endif()
+            string(APPEND code "            break;\n        }\n")
+        endforeach()
+        string(APPEND code
+            "        default: {\n"
+            "            status_ = QM_SUPER();\n"
+            "            break;\n"
+            "        }\n"
+            "    }\n"
+            "    return status_;\n}\n")
+    endforeach()
+
+    file(WRITE ${outdir}/${stem}_qmsm.h "${hdr}")
+    file(WRITE ${outdir}/${stem}_qmsm.c "${code}")
+endfunction()
+
+#............................................................................
+function(qpc_qmsm_generate target spec)
+    cmake_parse_arguments(ARG "" "OUTPUT_DIR" "" ${ARGN})
+    get_filename_component(spec ${spec} ABSOLUTE)
+    get_filename_component(stem ${spec} NAME_WE)
+    if(NOT ARG_OUTPUT_DIR)
+        set(ARG_OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/qmsm_gen)
+    endif()
+    file(MAKE_DIRECTORY ${ARG_OUTPUT_DIR})
+    set(out ${ARG_OUTPUT_DIR}/${stem}_qmsm.c ${ARG_OUTPUT_DIR}/${stem}_qmsm.h)
+    add_custom_command(OUTPUT ${out}
+        COMMAND ${CMAKE_COMMAND} -DQMSM_SPEC=${spec}
+            -DQMSM_OUT=${ARG_OUTPUT_DIR} -P ${_QPC_QMSM_GEN_SCRIPT}
+        DEPENDS ${spec} ${_QPC_QMSM_GEN_SCRIPT}
+        COMMENT "Generating QMsm code from ${stem}"
+        VERBATIM)
+    target_sources(${target} PRIVATE ${out})
+    target_include_directories(${target} PRIVATE ${ARG_OUTPUT_DIR})
+endfunction()
+
+set(_QPC_QMSM_GEN_SCRIPT ${CMAKE_CURRENT_LIST_FILE})
+
+# script mode (see the usage at the top of this file)
+if(CMAKE_SCRIPT_MODE_FILE AND DEFINED QMSM_SPEC)
+    if(NOT DEFINED QMSM_OUT)
+        set(QMSM_OUT ${CMAKE_CURRENT_BINARY_DIR})
+    endif()
+    _qmsm_generate(${QMSM_SPEC} ${QMSM_OUT})
+endif()
@@ -45,6 +45,9 @@
 struct QEvt;
 typedef struct {
     struct QEvt const *e;
+#ifdef QACTIVE_LATENCY_BINS
+    uint32_t ts; // enqueue timestamp
+#endif
 } QEvtPtr;
 
 //============================================================================
@@ -57,6 +60,12 @@ typedef struct QEQueue {
     QEQueueCtr tail;        //!< @private @memberof QEQueue
     QEQueueCtr nFree;       //!< @private @memberof QEQueue
     QEQueueCtr nMin;        //!< @private @memberof QEQueue
+#ifdef QF_EQUEUE_SPSC
+    uint8_t spsc;           //!< @private @memberof QEQueue
+#ifdef QF_EQUEUE_SPSC_CHECK
+    uintptr_t producer;     //!< @private @memberof QEQueue
+#endif
+#endif // def QF_EQUEUE_SPSC
 } QEQueue;
 
 //! @public @memberof QEQueue
@@ -91,4 +100,11 @@ uint16_t QEQueue_getMin(QEQueue const * const me);
 //! @public @memberof QEQueue
 bool QEQueue_isEmpty(QEQueue const * const me);
 
+#ifdef QF_EQUEUE_SPSC
+//! @public @memberof QEQueue
+void QEQueue_initSPSC(QEQueue * const me,
+    QEvtPtr * const qSto,
+    uint_fast16_t const qLen);
+#endif // def QF_EQUEUE_SPSC
+
 #endif // QEQUEUE_H_
@@ -79,6 +79,14 @@
 #error QF_EVENT_SIZ_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif
 
+#ifndef QHSM_MAX_NEST_DEPTH
+#define QHSM_MAX_NEST_DEPTH 6U
+#endif
+
+#if ((QHSM_MAX_NEST_DEPTH < 3U) || (QHSM_MAX_NEST_DEPTH > 32U))
+#error QHSM_MAX_NEST_DEPTH defined incorrectly, expected 3U..32U;
+#endif
+
 //! @endcond
 
 //----------------------------------------------------------------------------
@@ -134,6 +142,9 @@ bool QEvt_verify_(QEvt const * const me);
 // NOTE must be consistent with "qequeue.h"
 typedef struct {
     QEvt const *e;
+#ifdef QACTIVE_LATENCY_BINS
+    uint32_t ts; // enqueue timestamp
+#endif
 } QEvtPtr;
 #endif // QEQUEUE_HPP_
 
@@ -150,12 +161,28 @@ typedef QState (*QActionHandler)(void * const me);
 struct QXThread; // forward declaration
 typedef void (* QXThreadHandler )(struct QXThread * const me);
 
+#ifdef QMSM_SIG_MAP
+//! @struct QMSigAct
+// entry of the sparse signal map of a QMState (see QMSM_SIG_MAP)
+typedef struct QMSigAct {
+    QSignal sig;                        //!< @private @memberof QMSigAct
+    struct QMTranActTable const *tatbl; //!< @private @memberof QMSigAct
+} QMSigAct;
+#endif // def QMSM_SIG_MAP
+
 typedef struct QMState {
     struct QMState const *superstate; //!< @private @memberof QMState
     QStateHandler const stateHandler; //!< @private @memberof QMState
     QActionHandler const entryAction; //!< @private @memberof QMState
     QActionHandler const exitAction;  //!< @private @memberof QMState
     QActionHandler const initAction;  //!< @private @memberof QMState
+#ifdef QMSM_SIG_MAP
+    struct QMSigAct const *sigMap;    //!< @private @memberof QMState
+#endif
+#ifdef QASM_ANCESTRY
+    uint32_t const ancestry;          //!< @private @memberof QMState
+    uint8_t const index;              //!< @private @memberof QMState
+#endif
 } QMState;
 
 typedef struct QMTranActTable {
@@ -184,6 +211,9 @@ typedef struct {
     struct QAsmVtable const * vptr;   //!< @protected @memberof QAsm
     union QAsmAttr state;             //!< @protected @memberof QAsm
     union QAsmAttr temp;              //!< @protected @memberof QAsm
+#ifdef QHSM_CACHE
+    struct QHsmCache *cache;          //!< @private @memberof QAsm
+#endif
 } QAsm;
 
 // All possible values returned from state/action handlers...
@@ -202,6 +232,11 @@ typedef struct {
 #define Q_RET_EXIT      ((QState)7U)
 #define Q_RET_TRAN_INIT ((QState)8U)
 
+#ifdef QACTIVE_SNAPSHOT
+// used in the top-most initial tran. only (see QActive_restore())
+#define Q_RET_RESTORE   ((QState)9U)
+#endif
+
 // Reserved signals by the QP-framework (used in QHsm only)
 #define Q_EMPTY_SIG     ((QSignal)0U)
 #define Q_ENTRY_SIG     ((QSignal)1U)
@@ -231,6 +266,8 @@ struct QAsmVtable {
         (*((QAsm *)(me_))->vptr->init)((QAsm *)(me_), (par_), 0U)
     #define QASM_DISPATCH(me_, e_, dummy) \
         (*((QAsm *)(me_))->vptr->dispatch)((QAsm *)(me_), (e_), 0U)
+    #define QASM_IS_IN(me_, stateHndl_) \
+        (*((QAsm *)(me_))->vptr->isIn)((QAsm *)(me_), (stateHndl_))
 #endif // ndef Q_SPY
 
 #define QASM_GET_STATE_HANDLER(me_) \
@@ -238,6 +275,37 @@ struct QAsmVtable {
 
 #define Q_ASM_UPCAST(ptr_) ((QAsm *)(ptr_))
 
+#ifdef QASM_PROFILE
+#if ((QASM_PROFILE & (QASM_PROFILE - 1U)) != 0U) || (QASM_PROFILE > 0x8000U)
+#error QASM_PROFILE defined incorrectly, expected a power of 2 up to 0x8000U;
+#endif
+
+//! @struct QAsmProfile
+// dispatch profile of a state handler (see QAsm_getProfile()): # events
+// handled, # events passed to the superstate (unhandled) and # transitions
+// taken in the state, and the cumulative time of the RTC steps completed
+// in the state (in units of QF_onGetTime())
+typedef struct {
+    QStateHandler state;  //!< @public @memberof QAsmProfile
+    uint32_t nHandled;    //!< @public @memberof QAsmProfile
+    uint32_t nUnhandled;  //!< @public @memberof QAsmProfile
+    uint32_t nTran;       //!< @public @memberof QAsmProfile
+    uint32_t time;        //!< @public @memberof QAsmProfile
+} QAsmProfile;
+
+//! @static @public @memberof QAsm
+bool QAsm_getProfile(uint_fast16_t const idx,
+    QAsmProfile * const prof,
+    bool const reset);
+
+//! @static @private @memberof QAsm
+void QAsm_profRecord_(QStateHandler const hops[],
+    uint_fast8_t const nHops,
+    QStateHandler const state,
+    QState const r,
+    uint32_t const time);
+#endif // def QASM_PROFILE
+
 //----------------------------------------------------------------------------
 //! @class QHsm
 //! @extends QAsm
@@ -278,6 +346,58 @@ QStateHandler QHsm_state(QHsm const * const me);
 QStateHandler QHsm_childState(QHsm * const me,
     QStateHandler const parentHndl);
 
+// maximum depth of state nesting in a QHsm (including the top level)
+#define QHSM_MAX_NEST_DEPTH_  ((size_t)QHSM_MAX_NEST_DEPTH)
+
+#ifdef QHSM_CACHE
+//! @struct QHsmSuper
+// cached superstate and nesting depth (QHsm_top has depth 0) of a state
+typedef struct {
+    QStateHandler state;  //!< @private @memberof QHsmSuper
+    QStateHandler super;  //!< @private @memberof QHsmSuper
+#ifdef QASM_ANCESTRY
+    uint32_t ancestry;    //!< @private @memberof QHsmSuper
+    uint8_t index;        //!< @private @memberof QHsmSuper
+#endif
+    uint8_t depth;        //!< @private @memberof QHsmSuper
+} QHsmSuper;
+
+//! @struct QHsmTran
+// cached transition from 'source' to 'target' (see QHsmCache_initTran())
+typedef struct {
+    QStateHandler source; //!< @private @memberof QHsmTran
+    QStateHandler target; //!< @private @memberof QHsmTran
+    QStateHandler entry[QHSM_MAX_NEST_DEPTH_]; //!< @private @memberof QHsmTran
+    uint8_t nExit;        //!< @private @memberof QHsmTran
+    uint8_t nEntry;       //!< @private @memberof QHsmTran
+} QHsmTran;
+
+//! @class QHsmCache
+typedef struct QHsmCache {
+    QHsmSuper *superSto;  //!< @private @memberof QHsmCache
+    QHsmTran *tranSto;    //!< @private @memberof QHsmCache
+    uint16_t superMask;   //!< @private @memberof QHsmCache
+    uint16_t tranMask;    //!< @private @memberof QHsmCache
+#ifdef QASM_ANCESTRY
+    uint8_t nIndex;       //!< @private @memberof QHsmCache
+#endif
+} QHsmCache;
+
+//! @public @memberof QHsmCache
+void QHsmCache_ctor(QHsmCache * const me,
+    QHsmSuper * const superSto,
+    uint_fast16_t const superLen);
+
+//! @public @memberof QHsmCache
+void QHsmCache_initTran(QHsmCache * const me,
+    QHsmTran * const tranSto,
+    uint_fast16_t const tranLen);
+
+//! @public @memberof QHsm
+void QHsm_setCache(QHsm * const me,
+    QHsmCache * const cache);
+#endif // def QHSM_CACHE
+
 //! @private @memberof QHsm
 size_t QHsm_tran_simple_(
     QAsm * const me,
@@ -348,6 +468,12 @@ QMState const * QMsm_topQMState(void);
 //! @public @memberof QMsm
 QMState const * QMsm_stateObj(QMsm const * const me);
 
+#ifdef QASM_ANCESTRY
+//! @public @memberof QMsm
+bool QMsm_isInState(QMsm const * const me,
+    QMState const * const state);
+#endif
+
 //! @public @memberof QMsm
 QMState const * QMsm_childStateObj(QMsm const * const me,
     QMState const * const parentHndl);
@@ -382,11 +508,94 @@ QMState const * QMsm_childStateObj(QMsm const * const me,
 #define QM_SUPER()     ((QState)Q_RET_SUPER)
 #define QM_STATE_NULL  ((QMState *)0)
 
+// initializer of the QMState members present in all configurations, which
+// leaves the optional members (sigMap, ancestry, index) zero-initialized
+// without -Wmissing-field-initializers warnings (see QMSM_SIG_MAP)
+#define QMSTATE_INITIALIZER(super_, handler_, entry_, exit_, init_) { \
+    .superstate   = (super_),   \
+    .stateHandler = (handler_), \
+    .entryAction  = (entry_),   \
+    .exitAction   = (exit_),    \
+    .initAction   = (init_)     \
+}
+
+#ifdef QASM_ANCESTRY
+// maximum # states with ancestry bitsets in a state machine class
+#define QASM_ANCESTRY_BITS 32U
+#endif
+
+#ifdef QMSM_SIG_MAP
+#define QM_SIG_MAP_NULL ((QMSigAct *)0)
+#define QM_SIG_MAP_END  { (QSignal)0U, (struct QMTranActTable const *)0 }
+#endif // def QMSM_SIG_MAP
+
+//----------------------------------------------------------------------------
+// QEP component containers
+
+//! @struct QCompSub
+// interest of a component in a signal (see QCompSet_listen())
+typedef struct QCompSub {
+    QSignal sig;          //!< @private @memberof QCompSub
+    uint16_t id;          //!< @private @memberof QCompSub
+} QCompSub;
+
+//! @class QCompSet
+typedef struct {
+    uint8_t *compSto;     //!< @private @memberof QCompSet
+    QCompSub *subSto;     //!< @private @memberof QCompSet
+    uint16_t compSize;    //!< @private @memberof QCompSet
+    uint16_t nComp;       //!< @private @memberof QCompSet
+    uint16_t subLen;      //!< @private @memberof QCompSet
+    uint16_t nSub;        //!< @private @memberof QCompSet
+    bool isBusy;          //!< @private @memberof QCompSet
+} QCompSet;
+
+//! @public @memberof QCompSet
+void QCompSet_ctor(QCompSet * const me,
+    void * const compSto,
+    uint_fast16_t const compSize,
+    uint_fast16_t const nComp,
+    QCompSub * const subSto,
+    uint_fast16_t const subLen);
+
+//! @public @memberof QCompSet
+QAsm * QCompSet_get(QCompSet const * const me,
+    uint_fast16_t const id);
+
+//! @public @memberof QCompSet
+void QCompSet_init(QCompSet * const me,
+    void const * const par,
+    uint_fast8_t const qsId);
+
+//! @public @memberof QCompSet
+bool QCompSet_listen(QCompSet * const me,
+    QSignal const sig,
+    uint_fast16_t const id);
+
+//! @public @memberof QCompSet
+void QCompSet_unlisten(QCompSet * const me,
+    QSignal const sig,
+    uint_fast16_t const id);
+
+//! @public @memberof QCompSet
+uint_fast16_t QCompSet_dispatch(QCompSet * const me,
+    QEvt const * const e,
+    uint_fast8_t const qsId);
+
+//! @public @memberof QCompSet
+void QCompSet_dispatchTo(QCompSet * const me,
+    uint_fast16_t const id,
+    QEvt const * const e,
+    uint_fast8_t const qsId);
+
 //----------------------------------------------------------------------------
 // QF (active object framework) types
 
 typedef uint16_t QPrioSpec;
 
+// predicate for selecting events (e.g., see QActive_recallIf())
+typedef bool (*QEvtPred)(QEvt const * const e, void * const ctx);
+
 #if (QF_TIMEEVT_CTR_SIZE == 1U)
     typedef uint8_t QTimeEvtCtr;
 #elif (QF_TIMEEVT_CTR_SIZE == 2U)
@@ -439,9 +648,57 @@ void QPSet_remove(QPSet * const me, uint_fast8_t const n);
 //! @public @memberof QPSet
 uint_fast8_t QPSet_findMax(QPSet const * const me);
 
+#ifdef QF_MAX_SUBSCR
+//! @struct QSubscr
+typedef struct {
+    struct QActive *ao; //!< @private @memberof QSubscr
+    QEvtPred filter;    //!< @private @memberof QSubscr
+    void *ctx;          //!< @private @memberof QSubscr
+    uint32_t nDrop;     //!< @private @memberof QSubscr
+    uint16_t margin;    //!< @private @memberof QSubscr
+    uint8_t policy;     //!< @private @memberof QSubscr
+} QSubscr;
+
+//! overflow policies of subscriptions (see QActive_setSubscrPolicy())
+enum QSubscrPolicy {
+    Q_SUBSCR_ASSERT,   //!< subscriber queue overflow is an error (default)
+    Q_SUBSCR_DROP,     //!< drop the event and count the drop
+    Q_SUBSCR_CONFLATE, //!< replace the last queued event of the same signal
+};
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_STATS
+//! @struct QPubStats
+// per-signal publish statistics (see QActive_getPubStats()): # publishes,
+// # delivered and # dropped events, cumulative fan-out time (in units of
+// QF_onGetTime()) and the current # subscribers
+typedef struct {
+    uint32_t nPub;    //!< @public @memberof QPubStats
+    uint32_t nDeliv;  //!< @public @memberof QPubStats
+    uint32_t nDrop;   //!< @public @memberof QPubStats
+    uint32_t time;    //!< @public @memberof QPubStats
+    uint8_t nSubscr;  //!< @public @memberof QPubStats
+} QPubStats;
+#endif // def QF_PS_STATS
+
 //! @struct QSubscrList
 typedef struct {
     QPSet set;     //!< @private @memberof QSubscrList
+#ifdef QF_PS_SPARSE
+    QSignal sig;   //!< @private @memberof QSubscrList
+#endif
+#ifdef QF_MAX_SUBSCR
+    //! @private @memberof QSubscrList
+    QSubscr subscr[QF_MAX_SUBSCR]; // sorted by descending prio.
+    uint8_t nSubscr; //!< @private @memberof QSubscrList
+#endif // def QF_MAX_SUBSCR
+#ifdef QF_PS_RETAIN
+    QEvt const *retained; //!< @private @memberof QSubscrList
+    bool retain;          //!< @private @memberof QSubscrList
+#endif // def QF_PS_RETAIN
+#ifdef QF_PS_STATS
+    QPubStats stats;      //!< @private @memberof QSubscrList
+#endif // def QF_PS_STATS
 } QSubscrList;
 
 struct QEQueue; // forward declaration
@@ -465,6 +722,16 @@ typedef struct QActive {
 #ifdef QACTIVE_EQUEUE_TYPE
     QACTIVE_EQUEUE_TYPE eQueue; //!< @protected @memberof QActive
 #endif // def QACTIVE_EQUEUE_TYPE
+
+#ifdef QACTIVE_LATENCY_BINS
+    uint32_t latHist[QACTIVE_LATENCY_BINS]; //!< @private @memberof QActive
+    uint32_t latMax; //!< @private @memberof QActive
+#endif // def QACTIVE_LATENCY_BINS
+
+#ifdef QACTIVE_SUBSCR_INDEX
+    QSignal subscrSig[QACTIVE_SUBSCR_INDEX]; //!< @private @memberof QActive
+    uint8_t nSubscrSig; //!< @private @memberof QActive
+#endif // def QACTIVE_SUBSCR_INDEX
 } QActive;
 
 //! @protected @memberof QActive
@@ -509,10 +776,18 @@ void QActive_postLIFO_(QActive * const me,
 //! @private @memberof QActive
 QEvt const * QActive_get_(QActive * const me);
 
+#ifndef QF_PS_SPARSE
 //! @static @public @memberof QActive
 void QActive_psInit(
     QSubscrList * const subscrSto,
     enum_t const maxSignal);
+#else
+//! @static @public @memberof QActive
+void QActive_psInitSparse(
+    QSubscrList * const subscrSto,
+    uint_fast16_t const nSlots,
+    enum_t const maxSignal);
+#endif // ndef QF_PS_SPARSE
 
 //! @static @private @memberof QActive
 void QActive_publish_(
@@ -520,6 +795,31 @@ void QActive_publish_(
     void const * const sender,
     uint_fast8_t const qsId);
 
+//! @static @private @memberof QActive
+void QActive_publishN_(
+    QEvt const * const evts[],
+    uint_fast8_t const n,
+    void const * const sender,
+    uint_fast8_t const qsId);
+
+#ifdef QF_PS_RETAIN
+//! @static @public @memberof QActive
+void QActive_setRetain(
+    enum_t const sig,
+    bool const enable);
+#endif // def QF_PS_RETAIN
+
+#ifdef QF_PS_STATS
+//! @static @public @memberof QActive
+// NOTE: with QF_PS_SPARSE, the publishes of a signal without a slot in the
+// subscriber table (never subscribed nor retained) are not counted and the
+// returned statistics of such a signal are all zero.
+void QActive_getPubStats(
+    enum_t const sig,
+    QPubStats * const stats,
+    bool const reset);
+#endif // def QF_PS_STATS
+
 //! @static @public @memberof QActive
 uint16_t QActive_getQueueUse(uint_fast8_t const prio);
 
@@ -529,10 +829,41 @@ uint16_t QActive_getQueueFree(uint_fast8_t const prio);
 //! @static @public @memberof QActive
 uint16_t QActive_getQueueMin(uint_fast8_t const prio);
 
+#ifdef QF_EQUEUE_SPSC
+//! @public @memberof QActive
+void QActive_setSPSC(QActive * const me);
+#endif // def QF_EQUEUE_SPSC
+
+#ifdef QACTIVE_LATENCY_BINS
+//! @static @public @memberof QActive
+uint32_t QActive_getLatency(uint_fast8_t const prio,
+    uint32_t * const hist,
+    bool const reset);
+#endif // def QACTIVE_LATENCY_BINS
+
 //! @protected @memberof QActive
 void QActive_subscribe(QActive const * const me,
     enum_t const sig);
 
+#ifdef QF_MAX_SUBSCR
+//! @protected @memberof QActive
+void QActive_subscribeFiltered(QActive const * const me,
+    enum_t const sig,
+    QEvtPred const filter,
+    void * const ctx);
+
+//! @protected @memberof QActive
+void QActive_setSubscrPolicy(QActive const * const me,
+    enum_t const sig,
+    enum QSubscrPolicy const policy,
+    uint_fast16_t const margin);
+
+//! @protected @memberof QActive
+uint32_t QActive_getSubscrDrops(QActive const * const me,
+    enum_t const sig,
+    bool const reset);
+#endif // def QF_MAX_SUBSCR
+
 //! @protected @memberof QActive
 void QActive_unsubscribe(QActive const * const me,
     enum_t const sig);
@@ -540,6 +871,18 @@ void QActive_unsubscribe(QActive const * const me,
 //! @protected @memberof QActive
 void QActive_unsubscribeAll(QActive const * const me);
 
+#ifdef QF_MAX_SUBSCR_RANGE
+//! @protected @memberof QActive
+void QActive_subscribeRange(QActive const * const me,
+    enum_t const first,
+    enum_t const last);
+
+//! @protected @memberof QActive
+void QActive_unsubscribeRange(QActive const * const me,
+    enum_t const first,
+    enum_t const last);
+#endif // def QF_MAX_SUBSCR_RANGE
+
 //! @protected @memberof QActive
 bool QActive_defer(QActive const * const me,
     struct QEQueue * const eq,
@@ -549,11 +892,56 @@ bool QActive_defer(QActive const * const me,
 bool QActive_recall(QActive * const me,
     struct QEQueue * const eq);
 
+//! @protected @memberof QActive
+uint16_t QActive_recallN(QActive * const me,
+    struct QEQueue * const eq,
+    uint_fast16_t const num);
+
+//! @protected @memberof QActive
+bool QActive_recallIf(QActive * const me,
+    struct QEQueue * const eq,
+    QEvtPred const pred,
+    void * const ctx);
+
+//! @protected @memberof QActive
+bool QActive_recallSig(QActive * const me,
+    struct QEQueue * const eq,
+    enum_t const sig);
+
 //! @protected @memberof QActive
 uint16_t QActive_flushDeferred(QActive const * const me,
     struct QEQueue * const eq,
     uint_fast16_t const num);
 
+#ifdef QACTIVE_SNAPSHOT
+//! @struct QSnapDesc
+// the parts of an AO saved in a snapshot (see QActive_snapshot())
+typedef struct {
+    union QAsmAttr const *stateIds;   //!< @public @memberof QSnapDesc
+    void *blob;                       //!< @public @memberof QSnapDesc
+    struct QEQueue * const *deferred; //!< @public @memberof QSnapDesc
+    uint16_t nStateIds;               //!< @public @memberof QSnapDesc
+    uint16_t blobSize;                //!< @public @memberof QSnapDesc
+    uint8_t nDeferred;                //!< @public @memberof QSnapDesc
+} QSnapDesc;
+
+// entries of the registry of stable state IDs (QSnapDesc.stateIds)
+#define QSNAP_HSM_STATE(state_) { .fun = Q_STATE_CAST(state_) }
+#define QSNAP_MSM_STATE(state_) { .obj = (state_) }
+
+//! @protected @memberof QActive
+uint_fast16_t QActive_snapshot(QActive const * const me,
+    QSnapDesc const * const desc,
+    uint8_t * const buf,
+    uint_fast16_t const bufSize);
+
+//! @protected @memberof QActive
+QState QActive_restore(QActive * const me,
+    QSnapDesc const * const desc,
+    uint8_t const * const buf,
+    uint_fast16_t const len);
+#endif // def QACTIVE_SNAPSHOT
+
 //! @private @memberof QActive
 void QActive_evtLoop_(QActive * const me);
 
@@ -686,6 +1074,12 @@ void QF_onCleanup(void);
         QActive * next);
 #endif // def QF_ON_CONTEXT_SW
 
+#if (defined QACTIVE_LATENCY_BINS) || (defined QF_PS_STATS) \
+    || (defined QASM_PROFILE)
+    //! @static @public @memberof QF
+    uint32_t QF_onGetTime(void);
+#endif // (defined QACTIVE_LATENCY_BINS) || ... || (defined QASM_PROFILE)
+
 static inline QPrioSpec Q_PRIO(uint8_t const prio, uint8_t const pthre) {
     // combine the QF prio. preemption-threshold pthre in the upper byte
     return (QPrioSpec)((uint32_t)prio | ((uint32_t)pthre << 8U));
@@ -764,6 +1158,9 @@ void QF_gcFromISR(QEvt const * const e);
         (QActive_post_((me_), (e_), (margin_), (sender_)))
     #define QACTIVE_PUBLISH(e_, sender_) \
         (QActive_publish_((e_), (void const *)(sender_), (sender_)->prio))
+    #define QACTIVE_PUBLISH_N(evts_, n_, sender_) \
+        (QActive_publishN_((evts_), (n_), (void const *)(sender_), \
+                           (sender_)->prio))
     #define QTIMEEVT_TICK_X(tickRate_, sender_) (QTimeEvt_tick_((tickRate_), (sender_)))
     #define QTICKER_TRIG(ticker_, sender_) (QTicker_trig_((ticker_), (sender_)))
 #else
@@ -772,6 +1169,8 @@ void QF_gcFromISR(QEvt const * const e);
     #define QACTIVE_POST_X(me_, e_, margin_, dummy) \
         (QActive_post_((me_), (e_), (margin_), (void *)0))
     #define QACTIVE_PUBLISH(e_, dummy) (QActive_publish_((e_), (void *)0, 0U))
+    #define QACTIVE_PUBLISH_N(evts_, n_, dummy) \
+        (QActive_publishN_((evts_), (n_), (void *)0, 0U))
     #define QTIMEEVT_TICK_X(tickRate_, dummy) (QTimeEvt_tick_((tickRate_), (void *)0))
     #define QTICKER_TRIG(ticker_, sender_) (QTicker_trig_((ticker_), (void *)0))
 #endif // ndef Q_SPY
@@ -43,6 +43,56 @@ extern QSubscrList * QActive_subscrList_;
 //! @static @private @memberof QActive
 extern QSignal QActive_maxPubSignal_;
 
+#ifdef QF_PS_SPARSE
+//! @static @private @memberof QActive
+extern uint16_t QActive_subscrMask_;
+
+//! @static @private @memberof QActive
+QSubscrList * QActive_subscrFind_(
+    QSignal const sig,
+    bool const create);
+#else
+// subscriber list of the given signal in the dense QActive_subscrList_[]
+#define QActive_subscrFind_(sig_, create_) (&QActive_subscrList_[(sig_)])
+#endif // def QF_PS_SPARSE
+
+#ifdef QF_MAX_SUBSCR_RANGE
+//! @struct QSubscrRange
+// subscription of one AO to the signals first..last (inclusive)
+typedef struct {
+    QSignal first;  //!< @private @memberof QSubscrRange
+    QSignal last;   //!< @private @memberof QSubscrRange
+    uint8_t prio;   //!< @private @memberof QSubscrRange
+} QSubscrRange;
+
+//! @static @private @memberof QActive
+extern QSubscrRange QActive_subscrRange_[QF_MAX_SUBSCR_RANGE];
+
+//! @static @private @memberof QActive
+extern uint8_t QActive_nSubscrRange_;
+
+//! @static @private @memberof QActive
+extern QSubscrRange QActive_rangeSpan_; // span of all subscribed ranges
+
+//! @static @private @memberof QActive
+bool QActive_rangeSubscr_(
+    QSignal const sig,
+    QPSet * const subscrSet);
+
+#ifdef QF_MAX_SUBSCR
+//! @static @private @memberof QActive
+uint_fast8_t QActive_rangeMerge_(
+    QSubscr subscr[],
+    uint_fast8_t const nSubscr,
+    QPSet * const rangeSet);
+#endif
+#endif // def QF_MAX_SUBSCR_RANGE
+
+#if (defined QACTIVE_LATENCY_BINS) || (defined QACTIVE_SUBSCR_INDEX)
+//! @private @memberof QActive
+void QActive_ctorOpt_(QActive * const me);
+#endif
+
 #if (QF_MAX_TICK_RATE > 0U)
 //! @static @private @memberof QTimeEvt
 extern QTimeEvt QTimeEvt_timeEvtHead_[QF_MAX_TICK_RATE];
@@ -66,6 +116,67 @@ typedef struct {
 
 extern QF_Attr QF_priv_; //!< @static @private @memberof QF
 
+//----------------------------------------------------------------------------
+// publication of the QHsmCache entries, see NOTE1 in qep_hsm.c
+
+#ifdef QHSM_CACHE
+// NOTE: a QP port can override these operations, if needed
+#ifndef QHSM_CACHE_LOAD_ACQ_
+    #define QHSM_CACHE_LOAD_ACQ_(state_) \
+        (__atomic_load_n(&(state_), __ATOMIC_ACQUIRE))
+#endif
+#ifndef QHSM_CACHE_STORE_REL_
+    #define QHSM_CACHE_STORE_REL_(state_, val_) \
+        (__atomic_store_n(&(state_), (val_), __ATOMIC_RELEASE))
+#endif
+#endif // def QHSM_CACHE
+
+//----------------------------------------------------------------------------
+// single-producer/single-consumer (SPSC) event queue facilities
+
+#ifdef QF_EQUEUE_SPSC
+
+// atomic access to the SPSC event queue indices
+// NOTE: a QP port can override these operations, if needed
+#ifndef QF_SPSC_LOAD_ACQ_
+    #define QF_SPSC_LOAD_ACQ_(ctr_) \
+        (__atomic_load_n(&(ctr_), __ATOMIC_ACQUIRE))
+#endif
+#ifndef QF_SPSC_STORE_REL_
+    #define QF_SPSC_STORE_REL_(ctr_, val_) \
+        (__atomic_store_n(&(ctr_), (val_), __ATOMIC_RELEASE))
+#endif
+#ifndef QF_SPSC_FENCE_
+    #define QF_SPSC_FENCE_() (__atomic_thread_fence(__ATOMIC_SEQ_CST))
+#endif
+
+#ifdef QF_EQUEUE_SPSC_CHECK
+#ifndef QF_EQUEUE_SPSC_PRODUCER_
+    #error QF_EQUEUE_SPSC_CHECK requires QF_EQUEUE_SPSC_PRODUCER_() in the port
+#endif
+#endif // def QF_EQUEUE_SPSC_CHECK
+
+//! @private @memberof QEQueue
+bool QEQueue_pushSPSC_(QEQueue * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    bool * const wasEmpty);
+
+//! @private @memberof QEQueue
+QEvt const * QEQueue_popSPSC_(QEQueue * const me);
+
+#endif // def QF_EQUEUE_SPSC
+
+//----------------------------------------------------------------------------
+// event queueing latency facilities
+
+#ifdef QACTIVE_LATENCY_BINS
+    // record the enqueue timestamp in the given event queue entry
+    #define QACTIVE_EQUEUE_STAMP_(ptr_) ((ptr_).ts = QF_onGetTime())
+#else
+    #define QACTIVE_EQUEUE_STAMP_(ptr_) ((void)0)
+#endif // def QACTIVE_LATENCY_BINS
+
 //----------------------------------------------------------------------------
 // Duplicate Inverse Storage (DIS) facilities
 
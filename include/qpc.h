@@ -175,6 +175,7 @@ typedef char char_t;
 //! Use Q_ASSERT_STATIC() or better yet `_Static_assert()` instead.
 #define Q_ASSERT_COMPILE(expr_) Q_ASSERT_STATIC(expr_)
 
+#ifndef QF_PS_SPARSE
 //! @static @public @memberof QF
 //! @deprecated
 static inline void QF_psInit(
@@ -183,6 +184,7 @@ static inline void QF_psInit(
 {
     QActive_psInit(subscrSto, maxSignal);
 }
+#endif // ndef QF_PS_SPARSE
 
 //! @deprecated instead use: QASM_INIT()
 #define QHSM_INIT(me_, par_, qsId_)   QASM_INIT((me_), (par_), (qsId_))
@@ -49,6 +49,14 @@ Q_DEFINE_THIS_MODULE("qf_port")
 
 //============================================================================
 static void task_main(void *pvParameters);  // prototype
+
+#ifdef QF_MAX_SUBSCR
+static bool QActive_postSubscrFromISR_(
+    QSubscr const * const s,
+    QEvt const * const e,
+    BaseType_t * const pxHigherPriorityTaskWoken,
+    void const * const sender);
+#endif // def QF_MAX_SUBSCR
 static void task_main(void *pvParameters) { // FreeRTOS task signature
     QActive * const act = (QActive *)pvParameters;
 
@@ -444,11 +452,105 @@ void QActive_publishFromISR_(
     }
 #endif // (QF_MAX_EPOOL > 0U)
 
+    // subscriber list of the signal (might be NULL for sparse storage)
+    QSubscrList * const sl = QActive_subscrFind_(sig, false);
+
+#ifdef QF_MAX_SUBSCR
+    // make a local copy of the precomputed subscriber array, see NOTE4
+    uint_fast8_t nSubscr = (sl != (QSubscrList *)0) ? sl->nSubscr : 0U;
+#ifdef QF_MAX_SUBSCR_RANGE
+    QSubscr subscr[QF_MAX_SUBSCR + QF_MAX_SUBSCR_RANGE];
+#else
+    QSubscr subscr[QF_MAX_SUBSCR];
+#endif
+    for (uint_fast8_t i = 0U; i < nSubscr; ++i) {
+        subscr[i] = sl->subscr[i];
+    }
+#ifdef QF_MAX_SUBSCR_RANGE
+    QPSet rangeSet;
+    QPSet_setEmpty(&rangeSet);
+    if (QActive_rangeSubscr_(sig, &rangeSet)) { // any range subscribers?
+        nSubscr = QActive_rangeMerge_(subscr, nSubscr, &rangeSet);
+    }
+#endif
+#else
     // make a local, modifiable copy of the subscriber set
-    QPSet subscrSet = QActive_subscrList_[sig].set;
+    QPSet subscrSet;
+    if (sl != (QSubscrList *)0) {
+        subscrSet = sl->set;
+    }
+    else {
+        QPSet_setEmpty(&subscrSet);
+    }
+#ifdef QF_MAX_SUBSCR_RANGE
+    (void)QActive_rangeSubscr_(sig, &subscrSet); // add range subscribers
+#endif
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_STATS
+    if (sl != (QSubscrList *)0) {
+        ++sl->stats.nPub; // count the publish
+    }
+#endif
+
+#ifdef QF_PS_RETAIN
+    QEvt const *old = (QEvt *)0; // previously retained event
+    if ((sl != (QSubscrList *)0) && sl->retain) { // retained signal?
+#if (QF_MAX_EPOOL > 0U)
+        if (e->poolNum_ != 0U) { // is it a mutable event?
+            QEvt_refCtr_inc_(e); // referenced by the retained cache now
+        }
+#endif
+        old = sl->retained;
+        sl->retained = e; // replace the retained event
+    }
+#endif // def QF_PS_RETAIN
 
     portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
 
+#ifdef QF_PS_RETAIN
+#if (QF_MAX_EPOOL > 0U)
+    if (old != (QEvt *)0) { // was an event retained before?
+        QF_gcFromISR(old); // release the previously retained event
+    }
+#endif
+#endif // def QF_PS_RETAIN
+
+#ifdef QF_PS_STATS
+    uint32_t const start = QF_onGetTime(); // start of the fan-out
+#endif
+
+    uint_fast8_t nDeliv = 0U; // # events delivered to the subscribers
+#ifdef QF_MAX_SUBSCR
+    //QF_SCHED_LOCK_(p); // no scheduler locking in FreeRTOS
+    for (uint_fast8_t i = 0U; i < nSubscr; ++i) {
+        QEvtPred const filter = subscr[i].filter;
+        if ((filter != (QEvtPred)0) && (!(*filter)(e, subscr[i].ctx))) {
+            // the subscriber's filter rejects the event, see NOTE4
+        }
+        else if (QActive_postSubscrFromISR_(&subscr[i], e,
+                     pxHigherPriorityTaskWoken, sender))
+        {
+            ++nDeliv;
+        }
+        else { // dropped according to the subscriber's policy
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            if (sl != (QSubscrList *)0) {
+                for (uint_fast8_t j = 0U; j < sl->nSubscr; ++j) {
+                    if (sl->subscr[j].ao == subscr[i].ao) { // subscribed?
+                        ++sl->subscr[j].nDrop; // count the dropped event
+                        break;
+                    }
+                }
+#ifdef QF_PS_STATS
+                ++sl->stats.nDrop; // count the dropped event for the signal
+#endif
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+        }
+    }
+    //QF_SCHED_UNLOCK_(); // no scheduler locking in FreeRTOS
+#else
     if (QPSet_notEmpty(&subscrSet)) { // any subscribers?
         // the highest-prio subscriber
         uint_fast8_t p = QPSet_findMax(&subscrSet);
@@ -466,6 +568,7 @@ void QActive_publishFromISR_(
         do { // loop over all subscribers
             // QACTIVE_POST() asserts internally if the queue overflows
             QACTIVE_POST_FROM_ISR(a, e, pxHigherPriorityTaskWoken, sender);
+            ++nDeliv;
 
             QPSet_remove(&subscrSet, p); // remove the handled subscriber
             if (QPSet_notEmpty(&subscrSet)) {  // still more subscribers?
@@ -490,6 +593,20 @@ void QActive_publishFromISR_(
 
         //QF_SCHED_UNLOCK_(); // no scheduler locking in FreeRTOS
     }
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_STATS
+    if (sl != (QSubscrList *)0) {
+        uint32_t const time = QF_onGetTime() - start;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        sl->stats.nDeliv += nDeliv;
+        sl->stats.time   += time; // cumulative fan-out time
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    }
+#else
+    Q_UNUSED_PAR(nDeliv);
+#endif // def QF_PS_STATS
 
 #if (QF_MAX_EPOOL > 0U)
     // The following garbage collection step decrements the reference counter
@@ -499,6 +616,50 @@ void QActive_publishFromISR_(
 #endif // (QF_MAX_EPOOL > 0U)
 }
 
+#ifdef QF_MAX_SUBSCR
+//............................................................................
+//! @private @static @memberof QActive
+static bool QActive_postSubscrFromISR_(
+    QSubscr const * const s,
+    QEvt const * const e,
+    BaseType_t * const pxHigherPriorityTaskWoken,
+    void const * const sender)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    if (s->policy == (uint8_t)Q_SUBSCR_ASSERT) { // default policy?
+        // QACTIVE_POST() asserts internally if the queue overflows
+        QACTIVE_POST_FROM_ISR(s->ao, e, pxHigherPriorityTaskWoken, sender);
+        return true;
+    }
+
+    // best-effort subscriber (Q_SUBSCR_CONFLATE falls back to dropping,
+    // because conflating needs the native QP event queue)
+#if (QF_MAX_EPOOL > 0U)
+    UBaseType_t uxSavedInterruptStatus;
+    if (e->poolNum_ != 0U) { // is it a mutable event?
+        // hold an extra reference, which a failed post recycles
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        QEvt_refCtr_inc_(e);
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    }
+#endif
+    bool const posted = QACTIVE_POST_X_FROM_ISR(s->ao, e, s->margin,
+                            pxHigherPriorityTaskWoken, sender);
+#if (QF_MAX_EPOOL > 0U)
+    if (posted && (e->poolNum_ != 0U)) { // still holding the extra ref.?
+        // NOTE: the publisher still holds the event, so no recycling
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        QEvt_refCtr_dec_(e);
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    }
+#endif
+    return posted;
+}
+#endif // def QF_MAX_SUBSCR
+
 //----------------------------------------------------------------------------
 // QTimeEvt "fromISR"
 
@@ -886,3 +1047,10 @@ void QF_stop(void) {
 // preempt the event posting after checking the margin, but before actually
 // posting the event to the queue.
 //
+// NOTE4:
+// QActive_publishFromISR_() applies the same subscriptions as the task-level
+// QActive_publish_(): the subscription filters (evaluated in the ISR, so
+// they must be ISR-safe), the overflow policies (Q_SUBSCR_CONFLATE drops
+// the event, because the FreeRTOS message queues cannot be conflated), the
+// retained events and the publish statistics. The dropped events are
+// counted in the subscriptions just like at the task level.
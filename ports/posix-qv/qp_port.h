@@ -84,6 +84,12 @@ void QF_onClockTick(void);
 #include "qequeue.h"   // POSIX-QV needs the native event-queue
 #include "qmpool.h"    // POSIX-QV needs the native memory-pool
 #include "qp.h"        // QP platform-independent public interface
+#ifdef QF_SHM
+#include "qshm.h"      // shared-memory event channels between processes
+#endif
+#ifdef QF_BRIDGE
+#include "qbridge.h"   // publish-subscribe bridge between processes
+#endif
 
 //============================================================================
 // interface used only inside QF implementation, but not in applications
@@ -101,6 +107,9 @@ void QF_onClockTick(void);
     QPSet_insert(&QF_readySet_, (me_)->prio); \
     pthread_cond_signal(&QF_condVar_)
 
+// SPSC event queue customization for POSIX (producer thread ID)
+#define QF_EQUEUE_SPSC_PRODUCER_() ((uintptr_t)pthread_self())
+
 // QMPool operations
 #define QF_EPOOL_TYPE_  QMPool
 #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -113,6 +122,11 @@ void QF_onClockTick(void);
 #define QF_EPOOL_FREE_(ePool_)  ((uint16_t)(ePool_)->nFree)
 #define QF_EPOOL_MIN_(ePool_)   ((uint16_t)(ePool_)->nMin)
 
+#ifdef QF_SHM
+// recycling the events allocated in shared memory (see qshm.h)
+#define QF_EPOOL_EXT_PUT_(e_)   (QShm_gc_((e_)))
+#endif
+
 #include <pthread.h> // POSIX-thread API
 
 extern QPSet QF_readySet_;
@@ -0,0 +1,686 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qp_pkg.h"       // QP package-scope interface
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+    #include "qs_pkg.h"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QF_SHM // shared-memory event channels configured?
+
+#include <sys/mman.h>     // for mmap()/munmap()
+#include <sys/stat.h>     // for fstat()
+#include <fcntl.h>        // for O_* constants
+#include <unistd.h>       // for ftruncate(), close(), getpid()
+#include <signal.h>       // for kill()
+#include <errno.h>        // for errno, EOWNERDEAD, ETIMEDOUT
+#include <string.h>       // for memset(), strlen(), strcpy()
+#include <time.h>         // for clock_gettime()
+
+Q_DEFINE_THIS_MODULE("qshm")
+
+// "QSM1" marker of the initialized shared-memory segment
+#define QSHM_MAGIC      0x51534D31U
+
+// alignment of the queue ring buffer and the event blocks in the segment
+#define QSHM_ALIGN_(n_) (((n_) + 7U) & ~(uint32_t)7U)
+
+// conversion of the segment offsets to local pointers
+#define QSHM_EVT_(seg_, off_) ((QEvt *)((uint8_t *)(seg_) + (off_)))
+#define QSHM_RING_(seg_)      ((uint32_t *)((uint8_t *)(seg_) + (seg_)->ringOff))
+
+// shared-memory segment header, see NOTE1
+struct QShmSeg {
+    uint32_t magic;         // QSHM_MAGIC when the segment is initialized
+    uint32_t size;          // size of the whole segment [bytes]
+    pthread_mutex_t mutex;  // process-shared, robust mutex
+    pthread_cond_t  cond;   // process-shared cond.var. for the pump thread
+    pid_t ownerPid;         // the owner (recipient) process
+    pid_t peerPid;          // the peer (sender) process or 0
+
+    // event pool (offsets of free blocks linked through the blocks)
+    uint32_t blockSize;     // size of the event blocks [bytes]
+    uint32_t poolOff;       // offset of the first event block
+    uint32_t poolEnd;       // offset past the last event block
+    uint32_t freeHead;      // offset of the first free block or 0
+    uint32_t nTot;          // total # blocks
+    uint32_t nFree;         // # free blocks
+    uint32_t nMin;          // minimum # free blocks so far
+
+    // event queue (the same semantics as QEQueue, but with offsets)
+    uint32_t frontEvt;      // offset of the event at the front or 0
+    uint32_t ringOff;       // offset of the ring buffer
+    uint32_t end;           // # entries in the ring buffer
+    uint32_t head;          // ring index for inserting events
+    uint32_t tail;          // ring index for removing events
+    uint32_t qFree;         // # free queue entries (+1 for frontEvt)
+    uint32_t qMin;          // minimum # free queue entries so far
+};
+
+// channels open in this process (for recycling the events in QF_gc())
+static QShm *l_shm[QSHM_MAX];
+
+//! @static @private @memberof QShm
+static void QShm_register_(QShm * const me, bool const reg);
+
+//! @static @private @memberof QShm
+static QShm *QShm_find_(QEvt const * const e);
+
+//! @static @private @memberof QShm
+static void QShm_lock_(struct QShmSeg * const seg);
+
+//! @static @private @memberof QShm
+static void QShm_put_(struct QShmSeg * const seg, QEvt * const e);
+
+//! @static @private @memberof QShm
+static bool QShm_isAlive_(pid_t const pid);
+
+//! @static @private @memberof QShm
+static bool QShm_unlinkStale_(char const * const name);
+
+//! @static @private @memberof QShm
+static void *QShm_pump_(void *arg);
+
+//............................................................................
+//! @public @memberof QShm
+bool QShm_create(QShm * const me,
+    char const * const name,
+    uint_fast16_t const qLen,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const nEvts)
+{
+    // the POSIX shm name must start with '/' and fit in me->name[]
+    Q_REQUIRE_LOCAL(100, (name != (char *)0) && (name[0] == '/')
+        && (strlen(name) < sizeof(me->name)));
+    Q_REQUIRE_LOCAL(110, (qLen > 0U) && (nEvts > 0U)
+        && (evtSize >= sizeof(QEvt)));
+
+    memset(me, 0, sizeof(*me));
+    strcpy(me->name, name);
+
+    uint32_t const blockSize = QSHM_ALIGN_((uint32_t)evtSize);
+    uint32_t const ringOff = QSHM_ALIGN_((uint32_t)sizeof(struct QShmSeg));
+    uint32_t const poolOff =
+        QSHM_ALIGN_(ringOff + ((uint32_t)qLen * sizeof(uint32_t)));
+    uint32_t const size = poolOff + ((uint32_t)nEvts * blockSize);
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if ((fd < 0) && (errno == EEXIST) && QShm_unlinkStale_(name)) {
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600); // try again
+    }
+    if (fd < 0) { // segment cannot be created (e.g., channel in use)?
+        return false;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) { // cannot size the segment?
+        (void)close(fd);
+        (void)shm_unlink(name);
+        return false;
+    }
+    void * const base =
+        mmap((void *)0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd); // the mapping stays valid after closing fd
+    if (base == MAP_FAILED) {
+        (void)shm_unlink(name);
+        return false;
+    }
+
+    // NOTE: the segment is zero-filled by ftruncate()
+    struct QShmSeg * const seg = (struct QShmSeg *)base;
+
+    pthread_mutexattr_t mattr;
+    pthread_mutexattr_init(&mattr);
+    pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mattr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&seg->mutex, &mattr);
+    pthread_mutexattr_destroy(&mattr);
+
+    pthread_condattr_t cattr;
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&seg->cond, &cattr);
+    pthread_condattr_destroy(&cattr);
+
+    seg->size     = size;
+    seg->ownerPid = getpid();
+
+    // link all event blocks into the free list
+    seg->blockSize = blockSize;
+    seg->poolOff   = poolOff;
+    seg->poolEnd   = size;
+    seg->nTot      = (uint32_t)nEvts;
+    seg->nFree     = (uint32_t)nEvts;
+    seg->nMin      = (uint32_t)nEvts;
+    uint32_t next  = 0U; // the last block terminates the free list
+    // NOTE: the loop runs over the block index, because the offset of the
+    // first block (poolOff) can be smaller than the block size
+    for (uint32_t i = (uint32_t)nEvts; i > 0U; --i) {
+        uint32_t const off = poolOff + ((i - 1U) * blockSize);
+        *(uint32_t *)QSHM_EVT_(seg, off) = next;
+        next = off;
+    }
+    seg->freeHead  = next;
+
+    seg->ringOff   = ringOff;
+    seg->end       = (uint32_t)qLen;
+    seg->qFree     = (uint32_t)qLen + 1U; // +1 for frontEvt
+    seg->qMin      = seg->qFree;
+
+    // publish the initialized segment to the peer process
+    __atomic_store_n(&seg->magic, QSHM_MAGIC, __ATOMIC_RELEASE);
+
+    me->seg     = seg;
+    me->size    = size;
+    me->isOwner = true;
+    QShm_register_(me, true);
+
+    return true;
+}
+
+//............................................................................
+//! @public @memberof QShm
+bool QShm_open(QShm * const me,
+    char const * const name)
+{
+    // the POSIX shm name must start with '/' and fit in me->name[]
+    Q_REQUIRE_LOCAL(200, (name != (char *)0) && (name[0] == '/')
+        && (strlen(name) < sizeof(me->name)));
+
+    memset(me, 0, sizeof(*me));
+    strcpy(me->name, name);
+
+    int const fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) { // segment not created (yet)?
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0)
+        || ((size_t)st.st_size < sizeof(struct QShmSeg)))
+    {
+        (void)close(fd);
+        return false; // segment not sized (yet)
+    }
+    size_t const size = (size_t)st.st_size;
+    void * const base =
+        mmap((void *)0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd); // the mapping stays valid after closing fd
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    struct QShmSeg * const seg = (struct QShmSeg *)base;
+    if ((__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != QSHM_MAGIC)
+        || (seg->size != size))
+    {
+        (void)munmap(base, size);
+        return false; // segment not initialized (yet)
+    }
+
+    QShm_lock_(seg);
+    seg->peerPid = getpid(); // this process is the peer now
+    pthread_mutex_unlock(&seg->mutex);
+
+    me->seg     = seg;
+    me->size    = size;
+    me->isOwner = false;
+    QShm_register_(me, true);
+
+    return true;
+}
+
+//............................................................................
+//! @public @memberof QShm
+void QShm_start(QShm * const me,
+    QActive * const ao,
+    enum_t const deadSig)
+{
+    // only the owner of an open channel can start the pump thread once
+    Q_REQUIRE_LOCAL(300, (me->seg != (struct QShmSeg *)0)
+        && me->isOwner && (!me->isRunning) && (ao != (QActive *)0));
+
+    me->ao = ao;
+    QEvt_ctor(&me->deadEvt, deadSig); // deadSig==0 means no notification
+    me->isRunning = true;
+
+    int const err = pthread_create(&me->pump, (pthread_attr_t *)0,
+                                   &QShm_pump_, me);
+    Q_ASSERT_LOCAL(310, err == 0);
+}
+
+//............................................................................
+//! @public @memberof QShm
+bool QShm_close(QShm * const me) {
+    struct QShmSeg * const seg = me->seg;
+    if (seg == (struct QShmSeg *)0) { // not open?
+        return true;
+    }
+
+    if (me->isOwner) {
+        if (me->isRunning) { // pump thread running?
+            QShm_lock_(seg);
+            me->isRunning = false;
+            pthread_cond_broadcast(&seg->cond);
+            pthread_mutex_unlock(&seg->mutex);
+            pthread_join(me->pump, (void **)0);
+        }
+
+        // the shared events still referenced in this process (queued in
+        // the AO, deferred, retained, etc.) prevent unmapping, see NOTE2
+        if (__atomic_load_n(&me->nOut, __ATOMIC_ACQUIRE) != 0U) {
+            return false; // the channel stays open (without the pump)
+        }
+    }
+    else {
+        QShm_lock_(seg);
+        if (seg->peerPid == getpid()) { // still the peer of the channel?
+            seg->peerPid = 0; // closed properly (not dead)
+        }
+        pthread_mutex_unlock(&seg->mutex);
+    }
+
+    QShm_register_(me, false);
+    (void)munmap(seg, me->size);
+    if (me->isOwner) {
+        (void)shm_unlink(me->name);
+    }
+    me->seg = (struct QShmSeg *)0;
+
+    return true;
+}
+
+//............................................................................
+//! @public @memberof QShm
+bool QShm_post(QShm * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin)
+{
+    struct QShmSeg * const seg = me->seg;
+
+    // the event must be a new event allocated in this channel's pool
+    Q_REQUIRE_LOCAL(400, (seg != (struct QShmSeg *)0)
+        && (QShm_find_(e) == me)
+        && (e->poolNum_ == QSHM_POOL_NUM) && (e->refCtr_ == 0U));
+
+    uint32_t const off = (uint32_t)((uint8_t const *)e - (uint8_t *)seg);
+
+    QShm_lock_(seg);
+
+    uint32_t qFree = seg->qFree; // get member into temporary
+    bool const status = (margin == QF_NO_MARGIN)
+        || (qFree > (uint32_t)margin);
+    if (status) { // can post the event?
+
+        // the queue must have a free slot
+        Q_ASSERT_LOCAL(430, qFree != 0U);
+
+        --qFree; // one free entry just used up
+        seg->qFree = qFree; // update the original
+        if (seg->qMin > qFree) {
+            seg->qMin = qFree; // update minimum so far
+        }
+
+        if (seg->frontEvt == 0U) { // is the queue empty?
+            seg->frontEvt = off; // deliver event directly
+            pthread_cond_signal(&seg->cond); // wake up the pump thread
+        }
+        else { // queue was not empty, insert event into the ring-buffer
+            uint32_t head = seg->head; // get member into temporary
+            QSHM_RING_(seg)[head] = off; // insert event into buffer
+            if (head == 0U) { // need to wrap the head?
+                head = seg->end;
+            }
+            --head; // advance the head (counter-clockwise)
+            seg->head = head; // update the original
+        }
+    }
+
+    pthread_mutex_unlock(&seg->mutex);
+
+    if (!status) { // event cannot be posted?
+        QShm_put_(seg, (QEvt *)e); // recycle the event to avoid a leak
+    }
+
+    return status;
+}
+
+//............................................................................
+//! @public @memberof QShm
+bool QShm_isPeerAlive(QShm const * const me) {
+    struct QShmSeg * const seg = me->seg;
+    Q_REQUIRE_LOCAL(500, seg != (struct QShmSeg *)0);
+
+    QShm_lock_(seg);
+    pid_t const pid = me->isOwner ? seg->peerPid : seg->ownerPid;
+    pthread_mutex_unlock(&seg->mutex);
+
+    return (pid != 0) && QShm_isAlive_(pid);
+}
+
+//............................................................................
+//! @public @memberof QShm
+uint16_t QShm_getQueueMin(QShm const * const me) {
+    struct QShmSeg * const seg = me->seg;
+    Q_REQUIRE_LOCAL(600, seg != (struct QShmSeg *)0);
+
+    QShm_lock_(seg);
+    uint16_t const nMin = (uint16_t)seg->qMin;
+    pthread_mutex_unlock(&seg->mutex);
+
+    return nMin;
+}
+
+//............................................................................
+//! @public @memberof QShm
+uint16_t QShm_getPoolMin(QShm const * const me) {
+    struct QShmSeg * const seg = me->seg;
+    Q_REQUIRE_LOCAL(700, seg != (struct QShmSeg *)0);
+
+    QShm_lock_(seg);
+    uint16_t const nMin = (uint16_t)seg->nMin;
+    pthread_mutex_unlock(&seg->mutex);
+
+    return nMin;
+}
+
+//............................................................................
+//! @private @memberof QShm
+QEvt * QShm_newX_(QShm * const me,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig)
+{
+    struct QShmSeg * const seg = me->seg;
+
+    // the requested event size must fit in the shared event blocks
+    Q_REQUIRE_LOCAL(800, (seg != (struct QShmSeg *)0)
+        && (evtSize <= seg->blockSize));
+
+    QEvt *e = (QEvt *)0;
+
+    QShm_lock_(seg);
+
+    uint32_t nFree = seg->nFree; // get member into temporary
+    if ((margin == QF_NO_MARGIN) ? (nFree > 0U) : (nFree > margin)) {
+        e = QSHM_EVT_(seg, seg->freeHead);
+        seg->freeHead = *(uint32_t *)e; // unlink the block
+
+        --nFree; // one free block just used up
+        seg->nFree = nFree; // update the original
+        if (seg->nMin > nFree) {
+            seg->nMin = nFree; // update minimum so far
+        }
+    }
+
+    pthread_mutex_unlock(&seg->mutex);
+
+    if (e != (QEvt *)0) { // was e allocated correctly?
+        e->sig      = (QSignal)sig; // set the signal
+        e->poolNum_ = QSHM_POOL_NUM;
+        e->refCtr_  = 0U; // reference count starts at 0
+    }
+    else {
+        // failed allocation cannot be tolerated without margin
+        Q_ASSERT_LOCAL(830, margin != QF_NO_MARGIN);
+    }
+
+    return e;
+}
+
+//............................................................................
+//! @private @memberof QShm
+void QShm_gc_(QEvt * const e) {
+    QShm * const me = QShm_find_(e);
+
+    // the event must belong to one of the channels open in this process
+    Q_REQUIRE_LOCAL(900, me != (QShm *)0);
+
+    QShm_put_(me->seg, e);
+
+    if (me->isOwner) { // the event was delivered by the pump thread?
+        uint32_t const nOut =
+            __atomic_sub_fetch(&me->nOut, 1U, __ATOMIC_RELEASE);
+
+        // the count of the delivered events must not underflow
+        Q_ASSERT_LOCAL(910, nOut != ~0U);
+#ifdef Q_UNSAFE
+        Q_UNUSED_PAR(nOut);
+#endif
+    }
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static void QShm_register_(QShm * const me, bool const reg) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    uint_fast8_t i = 0U;
+    for (; i < QSHM_MAX; ++i) {
+        if (l_shm[i] == (reg ? (QShm *)0 : me)) { // slot found?
+            l_shm[i] = reg ? me : (QShm *)0;
+            break;
+        }
+    }
+
+    // the number of open channels must not exceed QSHM_MAX
+    Q_ASSERT_INCRIT(1010, i < QSHM_MAX);
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static QShm *QShm_find_(QEvt const * const e) {
+    QShm *me = (QShm *)0;
+    uint8_t const * const p = (uint8_t const *)e;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    for (uint_fast8_t i = 0U; i < QSHM_MAX; ++i) {
+        QShm * const shm = l_shm[i];
+        if (shm != (QShm *)0) {
+            uint8_t const * const base = (uint8_t const *)shm->seg;
+            if ((base + shm->seg->poolOff <= p)
+                && (p < base + shm->seg->poolEnd))
+            {
+                me = shm; // the event is in this channel's pool
+                break;
+            }
+        }
+    }
+
+    QF_CRIT_EXIT();
+
+    return me;
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static void QShm_lock_(struct QShmSeg * const seg) {
+    int const err = pthread_mutex_lock(&seg->mutex);
+    if (err == EOWNERDEAD) { // the other process died holding the mutex?
+        // NOTE: the other process could only die in one of the short
+        // sections above, which keep the pool and the queue consistent
+        // at every store of the offsets
+        pthread_mutex_consistent(&seg->mutex);
+    }
+    else {
+        Q_ASSERT_LOCAL(1100, err == 0);
+    }
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static void QShm_put_(struct QShmSeg * const seg, QEvt * const e) {
+    uint32_t const off = (uint32_t)((uint8_t *)e - (uint8_t *)seg);
+
+    QShm_lock_(seg);
+
+    // the pool must not receive more blocks than it can hold
+    Q_ASSERT_LOCAL(1210, seg->nFree < seg->nTot);
+
+    *(uint32_t *)e = seg->freeHead; // link the block to the free list
+    seg->freeHead = off;
+    ++seg->nFree; // one more free block
+
+    pthread_mutex_unlock(&seg->mutex);
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static bool QShm_isAlive_(pid_t const pid) {
+    // signal 0 only checks whether the process exists
+    return (kill(pid, 0) == 0) || (errno == EPERM);
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static bool QShm_unlinkStale_(char const * const name) {
+    bool stale = false;
+    int const fd = shm_open(name, O_RDWR, 0);
+    if (fd >= 0) {
+        struct stat st;
+        if ((fstat(fd, &st) == 0)
+            && ((size_t)st.st_size >= sizeof(struct QShmSeg)))
+        {
+            struct QShmSeg * const seg = (struct QShmSeg *)mmap((void *)0,
+                sizeof(struct QShmSeg), PROT_READ, MAP_SHARED, fd, 0);
+            if (seg != MAP_FAILED) {
+                // NOTE: ownerPid is set before the magic is published
+                // and does not change afterwards, see QShm_create()
+                stale = (__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE)
+                            == QSHM_MAGIC)
+                        && (!QShm_isAlive_(seg->ownerPid));
+                (void)munmap(seg, sizeof(struct QShmSeg));
+            }
+        }
+        (void)close(fd);
+    }
+    if (stale) { // the owner process has terminated without closing?
+        (void)shm_unlink(name);
+    }
+    return stale;
+}
+
+//............................................................................
+//! @static @private @memberof QShm
+static void *QShm_pump_(void *arg) {
+    QShm * const me = (QShm *)arg;
+    struct QShmSeg * const seg = me->seg;
+
+    QShm_lock_(seg);
+    while (me->isRunning) {
+        uint32_t const off = seg->frontEvt; // always remove from the front
+        if (off != 0U) { // any events in the queue?
+            uint32_t const qFree = seg->qFree + 1U; // one more free entry
+            seg->qFree = qFree; // update the # free
+
+            if (qFree <= seg->end) { // any events in the ring buffer?
+                uint32_t tail = seg->tail; // get member into temporary
+                seg->frontEvt = QSHM_RING_(seg)[tail];
+                if (tail == 0U) { // need to wrap the tail?
+                    tail = seg->end;
+                }
+                --tail; // advance the tail (counter-clockwise)
+                seg->tail = tail; // update the original
+            }
+            else {
+                seg->frontEvt = 0U; // queue becomes empty
+            }
+            pthread_mutex_unlock(&seg->mutex);
+
+            // the shared event becomes an ordinary mutable event here
+            __atomic_add_fetch(&me->nOut, 1U, __ATOMIC_RELAXED);
+            QACTIVE_POST(me->ao, QSHM_EVT_(seg, off), me);
+
+            QShm_lock_(seg);
+        }
+        else { // wait for events, but check the peer periodically
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ts.tv_nsec += (long)QSHM_POLL_MS * 1000000L;
+            ts.tv_sec  += ts.tv_nsec / 1000000000L;
+            ts.tv_nsec %= 1000000000L;
+
+            int const err =
+                pthread_cond_timedwait(&seg->cond, &seg->mutex, &ts);
+            if (err == EOWNERDEAD) { // the peer died holding the mutex?
+                pthread_mutex_consistent(&seg->mutex);
+            }
+            else if (err == ETIMEDOUT) {
+                pid_t const pid = seg->peerPid;
+                if ((pid != 0) && (!QShm_isAlive_(pid))) { // peer dead?
+                    seg->peerPid = 0; // report the dead peer only once
+                    if (me->deadEvt.sig != 0U) { // notification needed?
+                        pthread_mutex_unlock(&seg->mutex);
+                        QACTIVE_POST(me->ao, &me->deadEvt, me);
+                        QShm_lock_(seg);
+                    }
+                }
+            }
+            else {
+                // signaled or spurious wakeup -- check the queue again
+            }
+        }
+    }
+    pthread_mutex_unlock(&seg->mutex);
+
+    return (void *)0;
+}
+
+//============================================================================
+// NOTE1:
+// The segment is mapped at different addresses in different processes,
+// so the segment header and the shared data use only offsets relative to
+// the beginning of the segment (never pointers). The event pool is a free
+// list of fixed-size blocks linked through the first 32 bits of each block.
+// The event queue applies the same algorithm as QEQueue (the event at the
+// front plus a ring buffer, with the head and tail advancing
+// counter-clockwise), so it has the same capacity and margin semantics.
+// All accesses are protected by the process-shared, robust mutex, so the
+// death of a process holding the mutex does not block the other process.
+//
+// NOTE2:
+// QShm_create() takes over an existing segment of the same name only when
+// the segment is initialized and its owner process no longer exists (the
+// owner terminated without QShm_close()). A segment of a running owner,
+// or a segment still being initialized, makes QShm_create() fail.
+// In the owner process, the pump thread counts the shared events delivered
+// to the AO and QF_gc() counts them back when they are recycled. Until all
+// such events are recycled (they can still be queued, deferred, retained,
+// or otherwise referenced), QShm_close() stops the pump thread, but keeps
+// the segment mapped and returns false, so it can be called again later.
+
+#endif // def QF_SHM
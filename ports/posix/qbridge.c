@@ -0,0 +1,505 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qp_pkg.h"       // QP package-scope interface
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+    #include "qs_pkg.h"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QF_BRIDGE // publish-subscribe bridge configured?
+
+#include <sys/socket.h>   // for socket(), bind(), sendmsg(), recv()
+#include <sys/un.h>       // for struct sockaddr_un
+#include <netinet/in.h>   // for struct sockaddr_in
+#include <netinet/tcp.h>  // for TCP_NODELAY
+#include <arpa/inet.h>    // for htons(), htonl()
+#include <unistd.h>       // for close(), unlink()
+#include <errno.h>        // for errno, EINTR
+#include <string.h>       // for memset(), memcpy(), memmove(), strlen()
+#include <stdlib.h>       // for strtoul()
+
+Q_DEFINE_THIS_MODULE("qbridge")
+
+//! @private @memberof QBridge
+static int QBridge_socket_(char const * const addr, bool const isServer);
+
+//! @private @memberof QBridge
+static bool QBridge_flush_(QBridge * const me);
+
+//! @private @memberof QBridge
+static void QBridge_down_(QBridge * const me);
+
+//! @private @memberof QBridge
+static uint_fast16_t QBridge_rxFrames_(QBridge * const me,
+    uint_fast16_t const len);
+
+//! @private @memberof QBridge
+static void *QBridge_rxThread_(void *arg);
+
+//............................................................................
+//! @public @memberof QBridge
+void QBridge_ctor(QBridge * const me,
+    QBridgeSig const * const sigTbl,
+    uint_fast16_t const nSig,
+    enum_t const downSig)
+{
+    // the signal table must be provided
+    Q_REQUIRE_LOCAL(100, (sigTbl != (QBridgeSig *)0) && (nSig > 0U)
+        && (nSig <= 0xFFFFU));
+
+    for (uint_fast16_t i = 0U; i < nSig; ++i) {
+        // each signal must go in exactly one direction, see NOTE2 in qbridge.h
+        Q_REQUIRE_LOCAL(110, (sigTbl[i].dir == (uint8_t)QBRIDGE_OUT)
+            || (sigTbl[i].dir == (uint8_t)QBRIDGE_IN));
+
+        // each event must fit in the receive buffer
+        Q_REQUIRE_LOCAL(120, (sigTbl[i].evtSize >= sizeof(QEvt))
+            && ((sigTbl[i].evtSize - sizeof(QEvt) + sizeof(QBridgeHdr))
+                <= QBRIDGE_RX_SIZE));
+    }
+
+    QActive_ctor(&me->super, Q_STATE_CAST(0)); // superclass' ctor
+
+    static struct QAsmVtable const vtable = { // QBridge virtual table
+        &QBridge_init_,
+        &QBridge_dispatch_,
+        &QHsm_isIn_,
+        &QHsm_getStateHandler_
+    };
+    me->super.super.vptr = &vtable; // hook the vptr
+
+    me->sigTbl    = sigTbl;
+    me->nSig      = (uint16_t)nSig;
+    me->fd        = -1; // not connected yet
+    QEvt_ctor(&me->downEvt, downSig); // downSig==0 means no notification
+    me->isUp      = false;
+    me->isRunning = false;
+    me->nTx       = 0U;
+    me->nRxDrop   = 0U;
+}
+
+//............................................................................
+//! @public @memberof QBridge
+bool QBridge_listen(QBridge * const me,
+    char const * const addr)
+{
+    // the bridge must not be connected already
+    Q_REQUIRE_LOCAL(200, me->fd < 0);
+
+    int const lfd = QBridge_socket_(addr, true);
+    if (lfd < 0) { // cannot listen at the address?
+        return false;
+    }
+
+    int fd;
+    do {
+        fd = accept(lfd, (struct sockaddr *)0, (socklen_t *)0);
+    } while ((fd < 0) && (errno == EINTR));
+
+    (void)close(lfd); // only one peer per bridge
+    if (addr[0] == '/') { // UNIX-domain socket?
+        (void)unlink(addr); // the peer is connected already
+    }
+    else if (fd >= 0) { // accepted TCP socket?
+        int const on = 1; // the events are batched by the bridge already
+        (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+
+    me->fd = fd;
+    return fd >= 0;
+}
+
+//............................................................................
+//! @public @memberof QBridge
+bool QBridge_connect(QBridge * const me,
+    char const * const addr)
+{
+    // the bridge must not be connected already
+    Q_REQUIRE_LOCAL(300, me->fd < 0);
+
+    me->fd = QBridge_socket_(addr, false);
+    return me->fd >= 0;
+}
+
+//............................................................................
+//! @public @memberof QBridge
+void QBridge_close(QBridge * const me) {
+    if (me->fd < 0) { // not connected?
+        return;
+    }
+
+    if (me->isRunning) { // receiver thread running?
+        me->isRunning = false;
+        (void)shutdown(me->fd, SHUT_RDWR); // unblock the receiver thread
+        pthread_join(me->rx, (void **)0);
+    }
+    (void)close(me->fd);
+    me->fd = -1;
+}
+
+//............................................................................
+//! @public @memberof QBridge
+uint32_t QBridge_getRxDrops(QBridge const * const me) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t const nDrop = me->nRxDrop;
+    QF_CRIT_EXIT();
+
+    return nDrop;
+}
+
+//............................................................................
+//! @private @memberof QBridge
+void QBridge_init_(QAsm * const me,
+    void const * const par,
+    uint_fast8_t const qsId)
+{
+    Q_UNUSED_PAR(par);
+    Q_UNUSED_PAR(qsId);
+
+    QBridge * const bridge = (QBridge *)me;
+
+    // the bridge must be connected before it is started, see NOTE1
+    Q_REQUIRE_LOCAL(400, bridge->fd >= 0);
+
+    // instead of the top-most initial transition, QBridge subscribes to
+    // all outgoing signals and starts receiving the incoming events
+    for (uint_fast16_t i = 0U; i < bridge->nSig; ++i) {
+        if (bridge->sigTbl[i].dir == (uint8_t)QBRIDGE_OUT) {
+            QActive_subscribe(&bridge->super, bridge->sigTbl[i].sig);
+        }
+    }
+
+    bridge->isUp      = true;
+    bridge->isRunning = true;
+    int const err = pthread_create(&bridge->rx, (pthread_attr_t *)0,
+                                   &QBridge_rxThread_, bridge);
+    Q_ASSERT_LOCAL(410, err == 0);
+}
+
+//............................................................................
+//! @private @memberof QBridge
+void QBridge_dispatch_(QAsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qsId)
+{
+    Q_UNUSED_PAR(qsId);
+
+    QBridge * const bridge = (QBridge *)me;
+
+    if (e == &bridge->downEvt) { // connection lost in the receiver thread?
+        QBridge_down_(bridge);
+        return;
+    }
+    if (!bridge->isUp) { // not connected any more?
+        return; // the event is dropped
+    }
+
+    // find the outgoing signal in the table (linear, but typically short)
+    uint_fast16_t id = 0U;
+    for (; id < bridge->nSig; ++id) {
+        if ((bridge->sigTbl[id].sig == (enum_t)e->sig)
+            && (bridge->sigTbl[id].dir == (uint8_t)QBRIDGE_OUT))
+        {
+            break;
+        }
+    }
+    if (id == bridge->nSig) { // not a bridged signal?
+        return; // ignore the event
+    }
+
+    // hold on to the event until it is sent, see NOTE1
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    if (e->poolNum_ != 0U) { // is it a mutable event?
+        QEvt_refCtr_inc_(e);
+    }
+    QF_CRIT_EXIT();
+
+    uint_fast8_t const n = bridge->nTx;
+    bridge->txEvt[n]     = e;
+    bridge->txHdr[n].id  = (uint16_t)id;
+    bridge->txHdr[n].len =
+        (uint16_t)(bridge->sigTbl[id].evtSize - sizeof(QEvt));
+    bridge->nTx = (uint8_t)(n + 1U);
+
+    // send the batch when full or when no more events are waiting
+    if ((bridge->nTx == QBRIDGE_BATCH)
+        || (QActive_getQueueUse(bridge->super.prio) == 0U))
+    {
+        if (!QBridge_flush_(bridge)) { // connection lost?
+            QBridge_down_(bridge);
+        }
+    }
+}
+
+//............................................................................
+//! @private @memberof QBridge
+static int QBridge_socket_(char const * const addr, bool const isServer) {
+    // the address must be a socket path or a loopback port number
+    Q_REQUIRE_LOCAL(500, (addr != (char *)0) && (addr[0] != '\0'));
+
+    union {
+        struct sockaddr sa;
+        struct sockaddr_un un;
+        struct sockaddr_in in;
+    } sa;
+    memset(&sa, 0, sizeof(sa));
+    socklen_t saLen;
+    int fd;
+
+    if (addr[0] == '/') { // UNIX-domain socket?
+        // the socket path must fit in sockaddr_un
+        Q_REQUIRE_LOCAL(510, strlen(addr) < sizeof(sa.un.sun_path));
+
+        sa.un.sun_family = AF_UNIX;
+        memcpy(sa.un.sun_path, addr, strlen(addr) + 1U);
+        saLen = (socklen_t)sizeof(sa.un);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((fd >= 0) && isServer) {
+            (void)unlink(addr); // remove a stale socket (if any)
+        }
+    }
+    else { // TCP socket on the loopback interface
+        unsigned long const port = strtoul(addr, (char **)0, 10);
+        Q_REQUIRE_LOCAL(520, (port > 0U) && (port <= 0xFFFFU));
+
+        sa.in.sin_family      = AF_INET;
+        sa.in.sin_port        = htons((uint16_t)port);
+        sa.in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        saLen = (socklen_t)sizeof(sa.in);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0) {
+            int const on = 1;
+            if (isServer) {
+                (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR,
+                                 &on, sizeof(on));
+            }
+            else { // the events are batched by the bridge already
+                (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY,
+                                 &on, sizeof(on));
+            }
+        }
+    }
+    if (fd < 0) {
+        return -1;
+    }
+
+    bool ok;
+    if (isServer) {
+        ok = (bind(fd, &sa.sa, saLen) == 0) && (listen(fd, 1) == 0);
+    }
+    else {
+        ok = (connect(fd, &sa.sa, saLen) == 0);
+    }
+    if (!ok) {
+        (void)close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+//............................................................................
+//! @private @memberof QBridge
+static bool QBridge_flush_(QBridge * const me) {
+    uint_fast8_t const n = me->nTx;
+
+    // gather the headers and the parameters of all events in the batch
+    struct iovec iov[2U * QBRIDGE_BATCH];
+    uint_fast8_t nIov = 0U;
+    for (uint_fast8_t i = 0U; i < n; ++i) {
+        iov[nIov].iov_base = &me->txHdr[i];
+        iov[nIov].iov_len  = sizeof(QBridgeHdr);
+        ++nIov;
+        if (me->txHdr[i].len != 0U) { // any event parameters?
+            iov[nIov].iov_base = (void *)(me->txEvt[i] + 1);
+            iov[nIov].iov_len  = me->txHdr[i].len;
+            ++nIov;
+        }
+    }
+
+    // send the whole batch, resuming after partial writes, see NOTE2
+    bool ok = true;
+    struct iovec *v = &iov[0];
+    while (nIov > 0U) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov    = v;
+        msg.msg_iovlen = nIov;
+        ssize_t nBytes = sendmsg(me->fd, &msg, MSG_NOSIGNAL);
+        if (nBytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = false; // connection lost
+            break;
+        }
+        while ((nIov > 0U) && ((size_t)nBytes >= v->iov_len)) {
+            nBytes -= (ssize_t)v->iov_len; // this entry sent completely
+            ++v;
+            --nIov;
+        }
+        if (nIov > 0U) { // the entry sent partially?
+            v->iov_base = (uint8_t *)v->iov_base + nBytes;
+            v->iov_len -= (size_t)nBytes;
+        }
+    }
+
+    // release the sent (or abandoned) events
+    for (uint_fast8_t i = 0U; i < n; ++i) {
+#if (QF_MAX_EPOOL > 0U)
+        QF_gc(me->txEvt[i]);
+#endif
+        me->txEvt[i] = (QEvt *)0;
+    }
+    me->nTx = 0U;
+
+    return ok;
+}
+
+//............................................................................
+//! @private @memberof QBridge
+static void QBridge_down_(QBridge * const me) {
+    if (!me->isUp) { // already down?
+        return;
+    }
+    me->isUp = false;
+
+    // release the events not sent yet
+    for (uint_fast8_t i = 0U; i < me->nTx; ++i) {
+#if (QF_MAX_EPOOL > 0U)
+        QF_gc(me->txEvt[i]);
+#endif
+    }
+    me->nTx = 0U;
+
+    if (me->downEvt.sig != 0U) { // notification requested?
+        QACTIVE_PUBLISH(&me->downEvt, &me->super);
+    }
+}
+
+//............................................................................
+//! @private @memberof QBridge
+static uint_fast16_t QBridge_rxFrames_(QBridge * const me,
+    uint_fast16_t const len)
+{
+    uint_fast16_t pos = 0U;
+    for (;;) { // loop over all complete frames in the buffer
+        if ((len - pos) < sizeof(QBridgeHdr)) { // incomplete header?
+            break;
+        }
+        QBridgeHdr hdr;
+        memcpy(&hdr, &me->rxBuf[pos], sizeof(hdr)); // might be unaligned
+        if ((len - pos) < (sizeof(QBridgeHdr) + hdr.len)) { // incomplete?
+            break;
+        }
+        uint8_t const * const par = &me->rxBuf[pos + sizeof(QBridgeHdr)];
+        pos += sizeof(QBridgeHdr) + hdr.len;
+
+        // the incoming signal must be known and the parameters must fit
+        QBridgeSig const * const s = (hdr.id < me->nSig)
+                                     ? &me->sigTbl[hdr.id] : (QBridgeSig *)0;
+        QEvt *e = (QEvt *)0;
+        if ((s != (QBridgeSig *)0) && (s->dir == (uint8_t)QBRIDGE_IN)
+            && (hdr.len <= (s->evtSize - sizeof(QEvt))))
+        {
+            // allocate the event in the local pools (no assertion)
+            e = QF_newX_(s->evtSize, 0U, s->sig);
+        }
+        if (e != (QEvt *)0) {
+            uint8_t * const dst = (uint8_t *)(e + 1);
+            memcpy(dst, par, hdr.len);
+            memset(&dst[hdr.len], 0, (s->evtSize - sizeof(QEvt)) - hdr.len);
+            QACTIVE_PUBLISH(e, &me->super); // publish in this process
+        }
+        else { // unknown signal or event pool depleted
+            QF_CRIT_STAT
+            QF_CRIT_ENTRY();
+            ++me->nRxDrop;
+            QF_CRIT_EXIT();
+        }
+    }
+    return pos; // # bytes consumed
+}
+
+//............................................................................
+//! @private @memberof QBridge
+static void *QBridge_rxThread_(void *arg) {
+    QBridge * const me = (QBridge *)arg;
+    uint_fast16_t len = 0U; // # bytes in the receive buffer
+
+    while (me->isRunning) {
+        ssize_t const n = recv(me->fd, &me->rxBuf[len],
+                               QBRIDGE_RX_SIZE - len, 0);
+        if (n <= 0) {
+            if ((n < 0) && (errno == EINTR)) {
+                continue;
+            }
+            break; // connection closed or lost
+        }
+        len += (uint_fast16_t)n;
+
+        uint_fast16_t const used = QBridge_rxFrames_(me, len);
+        len -= used;
+        if (len == QBRIDGE_RX_SIZE) { // frame larger than the buffer?
+            break; // the byte stream cannot be resynchronized
+        }
+        if ((len > 0U) && (used > 0U)) { // partial frame at the end?
+            memmove(&me->rxBuf[0], &me->rxBuf[used], len);
+        }
+    }
+
+    if (me->isRunning && (me->downEvt.sig != 0U)) { // lost by the peer?
+        // let the bridge AO stop forwarding (in its own thread)
+        (void)QACTIVE_POST_X(&me->super, &me->downEvt, 0U, (void *)0);
+    }
+    return (void *)0;
+}
+
+#endif // def QF_BRIDGE
+
+//============================================================================
+// NOTE1:
+// The bridge AO sends its events only when its event queue is empty (or
+// when the batch is full), so a burst of published events is sent to the
+// peer with a single system call. Until then, the mutable events in the
+// batch are held with their reference counters, so the parameters are
+// sent straight from the events without copying.
+//
+// NOTE2:
+// The batch is sent with sendmsg(), which is the gather-write of writev()
+// with the MSG_NOSIGNAL flag, so that a lost connection returns an error
+// instead of raising the SIGPIPE signal in the process. A stream socket
+// can accept only part of the batch, in which case the rest is sent from
+// the first unsent byte.
@@ -0,0 +1,145 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QBRIDGE_H_
+#define QBRIDGE_H_
+
+#include <pthread.h>  // POSIX-thread API (for the receiver thread)
+
+// Publish-subscribe bridge between processes (POSIX), see NOTE1
+//
+// The bridge is an active object connected to the bridge in the peer
+// process over a UNIX-domain socket or a loopback TCP socket. It subscribes
+// to the outgoing signals and streams their events to the peer, batching
+// all events waiting in its queue into a single gather-write. A receiver
+// thread reads the incoming events, allocates them from the local event
+// pools and publishes them in the local process.
+
+#ifndef QBRIDGE_BATCH
+    // maximum number of events sent in one gather-write
+    #define QBRIDGE_BATCH 16U
+#endif
+
+#ifndef QBRIDGE_RX_SIZE
+    // size of the receive buffer [bytes] (must fit the largest event)
+    #define QBRIDGE_RX_SIZE 1024U
+#endif
+
+// direction of the bridged signals (see QBridgeSig)
+enum QBridgeDir {
+    QBRIDGE_OUT = 1U, //!< events published locally are sent to the peer
+    QBRIDGE_IN  = 2U, //!< events received from the peer are published
+};
+
+//============================================================================
+//! @struct QBridgeSig
+//! entry of the signal table shared by both sides of the bridge, see NOTE2
+typedef struct {
+    enum_t sig;       //!< local signal of the bridged events
+    uint16_t evtSize; //!< local size of the bridged events [bytes]
+    uint8_t dir;      //!< direction of the bridged events (QBridgeDir)
+} QBridgeSig;
+
+//! @struct QBridgeHdr
+//! header of every event frame in the byte stream
+typedef struct {
+    uint16_t id;      //!< index of the signal in the QBridgeSig table
+    uint16_t len;     //!< # bytes of the event parameters following
+} QBridgeHdr;
+
+//============================================================================
+//! @class QBridge
+//! @extends QActive
+typedef struct {
+    QActive super;                //!< @protected @memberof QBridge
+    QBridgeSig const *sigTbl;     //!< @private @memberof QBridge
+    uint16_t nSig;                //!< @private @memberof QBridge
+    int fd;                       //!< @private @memberof QBridge
+    pthread_t rx;                 //!< @private @memberof QBridge
+    QEvt downEvt;                 //!< @private @memberof QBridge
+    bool isUp;                    //!< @private @memberof QBridge
+    bool volatile isRunning;      //!< @private @memberof QBridge
+    uint8_t nTx;                  //!< @private @memberof QBridge
+    QEvt const *txEvt[QBRIDGE_BATCH];  //!< @private @memberof QBridge
+    QBridgeHdr txHdr[QBRIDGE_BATCH];   //!< @private @memberof QBridge
+    uint32_t nRxDrop;             //!< @private @memberof QBridge
+    uint8_t rxBuf[QBRIDGE_RX_SIZE];    //!< @private @memberof QBridge
+} QBridge;
+
+//! @public @memberof QBridge
+void QBridge_ctor(QBridge * const me,
+    QBridgeSig const * const sigTbl,
+    uint_fast16_t const nSig,
+    enum_t const downSig);
+
+//! @public @memberof QBridge
+bool QBridge_listen(QBridge * const me,
+    char const * const addr);
+
+//! @public @memberof QBridge
+bool QBridge_connect(QBridge * const me,
+    char const * const addr);
+
+//! @public @memberof QBridge
+void QBridge_close(QBridge * const me);
+
+//! @public @memberof QBridge
+uint32_t QBridge_getRxDrops(QBridge const * const me);
+
+//! @private @memberof QBridge
+void QBridge_init_(QAsm * const me,
+    void const * const par,
+    uint_fast8_t const qsId);
+
+//! @private @memberof QBridge
+void QBridge_dispatch_(QAsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qsId);
+
+//============================================================================
+// NOTE1:
+// The address of the bridge is either the path of a UNIX-domain socket
+// (starting with '/') or the port number of a TCP socket on the loopback
+// interface (e.g., "6601"). One process calls QBridge_listen(), which
+// blocks until the peer connects, and the other calls QBridge_connect().
+// Either call must succeed before the bridge AO is started with
+// QActive_start(). The events are streamed in the host byte order and
+// must be "Plain Old Data" (no pointers), because only the bytes of the
+// event parameters are sent. When the connection is lost, the bridge stops
+// forwarding and (if 'downSig' is not zero) publishes the 'downSig' event.
+//
+// NOTE2:
+// Both processes must use signal tables with the same entries in the same
+// order, because the index of an entry identifies the signal in the byte
+// stream. The local signal numbers can differ between the processes. The
+// received parameters are copied to the local event and the rest of it (if
+// the local event is larger) is zeroed. Each entry must be QBRIDGE_OUT on
+// one side and QBRIDGE_IN on the other. An entry cannot be both, because
+// the bridge would then send back the events it publishes itself.
+
+#endif // QBRIDGE_H_
@@ -0,0 +1,134 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QSHM_H_
+#define QSHM_H_
+
+#include <pthread.h>  // POSIX-thread API (for the pump thread)
+
+// Shared-memory event channels between processes (POSIX/Linux), see NOTE1
+//
+// A channel is a shm_open()/mmap() segment with a pool of fixed-size event
+// blocks and an event queue (with the same semantics as QEQueue), both
+// protected by a process-shared, robust mutex. The process that creates
+// the channel owns the recipient active object. A "pump" thread in that
+// process moves the events from the shared queue to the AO's event queue.
+// The peer process opens the channel, allocates events in the shared pool
+// and posts them to the channel.
+
+#ifndef QSHM_POLL_MS
+    // period of checking whether the peer process is alive [ms]
+    #define QSHM_POLL_MS 100U
+#endif
+
+#ifndef QSHM_MAX
+    // maximum number of the channels open in one process
+    #define QSHM_MAX 4U
+#endif
+
+// the poolNum_ of the events allocated in the shared-memory pools
+#define QSHM_POOL_NUM 0xFFU
+
+struct QShmSeg; // shared-memory segment (opaque)
+
+//============================================================================
+//! @class QShm
+typedef struct {
+    struct QShmSeg *seg;  //!< @private @memberof QShm
+    size_t size;          //!< @private @memberof QShm
+    QActive *ao;          //!< @private @memberof QShm
+    QEvt deadEvt;         //!< @private @memberof QShm
+    pthread_t pump;       //!< @private @memberof QShm
+    uint32_t nOut;        //!< @private @memberof QShm
+    bool isOwner;         //!< @private @memberof QShm
+    bool volatile isRunning; //!< @private @memberof QShm
+    char name[32];        //!< @private @memberof QShm
+} QShm;
+
+//! @public @memberof QShm
+bool QShm_create(QShm * const me,
+    char const * const name,
+    uint_fast16_t const qLen,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const nEvts);
+
+//! @public @memberof QShm
+bool QShm_open(QShm * const me,
+    char const * const name);
+
+//! @public @memberof QShm
+void QShm_start(QShm * const me,
+    QActive * const ao,
+    enum_t const deadSig);
+
+//! @public @memberof QShm
+bool QShm_close(QShm * const me);
+
+//! @public @memberof QShm
+bool QShm_post(QShm * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin);
+
+//! @public @memberof QShm
+bool QShm_isPeerAlive(QShm const * const me);
+
+//! @public @memberof QShm
+uint16_t QShm_getQueueMin(QShm const * const me);
+
+//! @public @memberof QShm
+uint16_t QShm_getPoolMin(QShm const * const me);
+
+//! @private @memberof QShm
+QEvt * QShm_newX_(QShm * const me,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig);
+
+//! @private @memberof QShm
+void QShm_gc_(QEvt * const e);
+
+#define Q_NEW_SHM(shm_, evtT_, sig_) \
+    ((evtT_ *)QShm_newX_((shm_), (uint_fast16_t)sizeof(evtT_), \
+                         QF_NO_MARGIN, (enum_t)(sig_)))
+#define Q_NEW_SHM_X(shm_, evtT_, margin_, sig_) \
+    ((evtT_ *)QShm_newX_((shm_), (uint_fast16_t)sizeof(evtT_), \
+                         (margin_), (enum_t)(sig_)))
+
+//============================================================================
+// NOTE1:
+// The events exchanged through a channel must be "Plain Old Data" (no
+// pointers), because the segment is mapped at different addresses in
+// different processes. The shared events are allocated with Q_NEW_SHM()
+// in the peer process and must be posted only with QShm_post(), which
+// transfers the ownership of the event to the owner process. In the owner
+// process, the events are ordinary mutable events, which can be posted,
+// published and referenced further, and which are recycled back to the
+// shared pool by QF_gc(). The owner gets notified with the 'deadSig' event
+// when the peer process terminates without closing the channel.
+
+#endif // QSHM_H_
@@ -117,6 +117,22 @@ void QF_onClockTick(void);
     QPSet_insert(&QF_readySet_, (me_)->prio); \
     (void)SetEvent(QF_win32Event_)
 
+// SPSC event queue customization for Win32 (producer thread ID)
+#define QF_EQUEUE_SPSC_PRODUCER_() ((uintptr_t)GetCurrentThreadId())
+
+#ifdef _MSC_VER
+// SPSC event queue atomics for Visual C++, see NOTE3
+#define QF_SPSC_LOAD_ACQ_(ctr_)  (*(QEQueueCtr volatile *)&(ctr_))
+#define QF_SPSC_STORE_REL_(ctr_, val_) \
+    (*(QEQueueCtr volatile *)&(ctr_) = (val_))
+#define QF_SPSC_FENCE_()         MemoryBarrier()
+
+// QHsmCache entry publication for Visual C++, see NOTE3
+#define QHSM_CACHE_LOAD_ACQ_(state_) (*(QStateHandler volatile *)&(state_))
+#define QHSM_CACHE_STORE_REL_(state_, val_) \
+    (*(QStateHandler volatile *)&(state_) = (val_))
+#endif // def _MSC_VER
+
 // QMPool operations
 #define QF_EPOOL_TYPE_  QMPool
 #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -198,6 +214,14 @@ extern HANDLE QF_win32Event_; // Win32 event to signal events
 // Scheduler locking (used inside QF_publish_()) is not needed in the single-
 // threaded Win32-QV port, because event multicasting is already atomic.
 //
+// NOTE3:
+// Visual C++ does not provide the GCC/Clang __atomic builtins used by default
+// for the single-producer/single-consumer event queues (QF_EQUEUE_SPSC) and
+// for publishing the entries of the state machine caches (QHSM_CACHE).
+// Instead, this port relies on the Microsoft-specific semantics of volatile
+// accesses (acquire for loads and release for stores, /volatile:ms), which
+// is the default for the x86 and x64 targets.
+//
 
 #endif // QP_PORT_H_
 
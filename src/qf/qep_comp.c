@@ -0,0 +1,236 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qp_pkg.h"       // QP package-scope interface
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+    #include "qs_pkg.h"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+Q_DEFINE_THIS_MODULE("qep_comp")
+
+//! @static @private @memberof QCompSet
+static uint_fast16_t QCompSet_lowerBound_(QCompSet const * const me,
+    QSignal const sig,
+    uint_fast16_t const id);
+
+//............................................................................
+//! @public @memberof QCompSet
+void QCompSet_ctor(QCompSet * const me,
+    void * const compSto,
+    uint_fast16_t const compSize,
+    uint_fast16_t const nComp,
+    QCompSub * const subSto,
+    uint_fast16_t const subLen)
+{
+    // the components must be provided and must be state machines
+    Q_REQUIRE_LOCAL(100, (compSto != (void *)0)
+        && (sizeof(QAsm) <= compSize) && (compSize <= 0xFFFFU)
+        && (0U < nComp) && (nComp <= 0xFFFFU));
+
+    // the signal-interest storage is optional
+    Q_REQUIRE_LOCAL(110, ((subSto != (QCompSub *)0) || (subLen == 0U))
+        && (subLen <= 0xFFFFU));
+
+    me->compSto  = (uint8_t *)compSto;
+    me->subSto   = subSto;
+    me->compSize = (uint16_t)compSize;
+    me->nComp    = (uint16_t)nComp;
+    me->subLen   = (uint16_t)subLen;
+    me->nSub     = 0U;
+    me->isBusy   = false;
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+QAsm * QCompSet_get(QCompSet const * const me,
+    uint_fast16_t const id)
+{
+    // the component id must be in range
+    Q_REQUIRE_LOCAL(200, id < me->nComp);
+
+    return (QAsm *)&me->compSto[(size_t)id * me->compSize];
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+void QCompSet_init(QCompSet * const me,
+    void const * const par,
+    uint_fast8_t const qsId)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(qsId);
+#endif
+
+    // NOTE: the components must be already constructed by the application
+    uint8_t *comp = &me->compSto[0];
+    for (uint_fast16_t id = 0U; id < me->nComp; ++id) {
+        QASM_INIT((QAsm *)comp, par, qsId); // top-most initial tran.
+        comp = &comp[me->compSize];
+    }
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+bool QCompSet_listen(QCompSet * const me,
+    QSignal const sig,
+    uint_fast16_t const id)
+{
+    // the component id must be in range and the interests cannot
+    // change while an event is dispatched to the components, see NOTE1
+    Q_REQUIRE_LOCAL(300, (id < me->nComp) && (!me->isBusy));
+
+    uint_fast16_t const i = QCompSet_lowerBound_(me, sig, id);
+    bool isListening = (i < me->nSub) // already listening?
+        && (me->subSto[i].sig == sig) && (me->subSto[i].id == id);
+    if ((!isListening) && (me->nSub < me->subLen)) { // free entry?
+        // move the following interests up (bounded by subLen)
+        for (uint_fast16_t k = me->nSub; k > i; --k) {
+            me->subSto[k] = me->subSto[k - 1U];
+        }
+        me->subSto[i].sig = sig;
+        me->subSto[i].id  = (uint16_t)id;
+        ++me->nSub;
+        isListening = true;
+    }
+    return isListening; // 'false' when the interest storage is full
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+void QCompSet_unlisten(QCompSet * const me,
+    QSignal const sig,
+    uint_fast16_t const id)
+{
+    // the component id must be in range and the interests cannot
+    // change while an event is dispatched to the components, see NOTE1
+    Q_REQUIRE_LOCAL(400, (id < me->nComp) && (!me->isBusy));
+
+    uint_fast16_t const i = QCompSet_lowerBound_(me, sig, id);
+    if ((i < me->nSub)
+        && (me->subSto[i].sig == sig) && (me->subSto[i].id == id))
+    {
+        --me->nSub;
+        // move the following interests down (bounded by subLen)
+        for (uint_fast16_t k = i; k < me->nSub; ++k) {
+            me->subSto[k] = me->subSto[k + 1U];
+        }
+    }
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+uint_fast16_t QCompSet_dispatch(QCompSet * const me,
+    QEvt const * const e,
+    uint_fast8_t const qsId)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(qsId);
+#endif
+
+    // the event must be valid and cannot be dispatched recursively
+    Q_REQUIRE_LOCAL(500, (e != (QEvt *)0) && (!me->isBusy));
+
+    me->isBusy = true;
+    QSignal const sig = e->sig;
+    uint_fast16_t n = 0U; // # components the event was dispatched to
+    uint_fast16_t i = QCompSet_lowerBound_(me, sig, 0U);
+
+    // the interests in 'sig' are adjacent and ordered by the component id,
+    // so the components are visited in the order of their storage
+    for (; (i < me->nSub) && (me->subSto[i].sig == sig); ++i) {
+        size_t const offset = (size_t)me->subSto[i].id * me->compSize;
+        QASM_DISPATCH((QAsm *)&me->compSto[offset], e, qsId);
+        ++n;
+    }
+    me->isBusy = false;
+
+    return n;
+}
+
+//............................................................................
+//! @public @memberof QCompSet
+void QCompSet_dispatchTo(QCompSet * const me,
+    uint_fast16_t const id,
+    QEvt const * const e,
+    uint_fast8_t const qsId)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(qsId);
+#endif
+
+    // the event must be valid
+    Q_REQUIRE_LOCAL(600, e != (QEvt *)0);
+
+    QASM_DISPATCH(QCompSet_get(me, id), e, qsId); // checks the id range
+}
+
+//............................................................................
+//! @static @private @memberof QCompSet
+static uint_fast16_t QCompSet_lowerBound_(QCompSet const * const me,
+    QSignal const sig,
+    uint_fast16_t const id)
+{
+    // binary search for the first interest not below (sig, id)
+    uint_fast16_t lo = 0U;
+    uint_fast16_t hi = me->nSub;
+    while (lo < hi) {
+        uint_fast16_t const mid = lo + ((hi - lo) >> 1U);
+        QCompSub const * const sub = &me->subSto[mid];
+        if ((sub->sig < sig) || ((sub->sig == sig) && (sub->id < id))) {
+            lo = mid + 1U;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//============================================================================
+// NOTE1:
+// The component set holds many state machines of the same class (e.g.,
+// one QHsm per device) in a contiguous array owned by the application and
+// dispatches the events of the owning active object to them. The
+// components are addressed by their index in the array (the instance id).
+// QCompSet_dispatchTo() routes an event directly to one component (keyed
+// routing), while QCompSet_dispatch() delivers it only to the components
+// that expressed the interest in the signal with QCompSet_listen(). The
+// interests are kept in a single array sorted by signal and id, so the
+// interested components are found by a binary search and are visited in
+// the order of their storage. Changing the interests costs O(n), which is
+// intended for the setup and for infrequent changes. The interests cannot
+// change while QCompSet_dispatch() is in progress (e.g., from within the
+// state machine of a component), because that would invalidate the scan.
+// The container does not use critical sections, because (like the
+// components themselves) it belongs to the thread of one active object.
@@ -39,10 +39,6 @@
 
 Q_DEFINE_THIS_MODULE("qep_hsm")
 
-// maximum depth of state nesting in a QHsm (including the top level),
-// must be >= 3
-#define QHSM_MAX_NEST_DEPTH_  ((size_t)6U)
-
 //! @cond INTERNAL
 
 // array of immutable events corresponding to the reserved signals
@@ -53,6 +49,41 @@ static QEvt const l_resEvt_[4] = {
     QEVT_INITIALIZER(Q_INIT_SIG)
 };
 
+#ifdef QHSM_CACHE
+// find the superstate of 'state_' (placed in me->temp) in the cache
+#define QHSM_SUPER_(me_, state_) (QHsm_super_((me_), (state_)))
+
+static QState QHsm_super_(QAsm * const me,
+    QStateHandler const s);
+
+static QHsmSuper const * QHsmCache_find_(QHsmCache const * const me,
+    QStateHandler const s);
+
+static void QHsmCache_insert_(QHsmCache * const me,
+    QStateHandler const s,
+    QStateHandler const super,
+    uint_fast8_t const depth);
+
+static size_t QHsm_tran_cached_(QAsm * const me,
+    QStateHandler * const path,
+    uint_fast8_t const qsId);
+#else
+// find the superstate of 'state_' (placed in me->temp) by calling 'state_'
+#define QHSM_SUPER_(me_, state_) \
+    ((*(state_))((me_), &l_resEvt_[Q_EMPTY_SIG]))
+#endif // def QHSM_CACHE
+
+#if (defined QHSM_CACHE) || (defined QASM_PROFILE)
+static uint_fast16_t QHsmCache_hash_(QStateHandler const s);
+#endif
+
+#ifdef QASM_PROFILE
+// the dispatch profiles of the state handlers (open addressing)
+static QAsmProfile l_profile_[QASM_PROFILE];
+
+static QAsmProfile * QAsm_profFind_(QStateHandler const state);
+#endif
+
 //! @endcond
 
 //============================================================================
@@ -149,6 +180,9 @@ void QHsm_ctor(QHsm * const me,
     me->super.vptr      = &vtable; // QHsm class' VTABLE
     me->super.state.fun = Q_STATE_CAST(&QHsm_top); // the current state (top)
     me->super.temp.fun  = initial; // the initial tran. handler
+#ifdef QHSM_CACHE
+    me->super.cache     = (QHsmCache *)0; // no superstate cache by default
+#endif
 }
 
 //............................................................................
@@ -196,6 +230,24 @@ void QHsm_init_(QAsm * const me,
     // execute the top-most initial tran.
     QState const r = (*me->temp.fun)(me, Q_EVT_CAST(QEvt));
 
+#ifdef QACTIVE_SNAPSHOT
+    if (r == Q_RET_RESTORE) { // state restored from a snapshot? see NOTE5
+        // the restored state must be set in temp
+        Q_ASSERT_LOCAL(220, me->temp.fun != Q_STATE_CAST(0));
+
+        QS_TRAN_SEG_(QS_QEP_STATE_INIT, s, me->temp.fun); // output QS record
+        QS_TOP_INIT_(QS_QEP_INIT_TRAN, me->temp.fun); // output QS record
+
+        // no entry actions and no initial transitions
+        me->state.fun = me->temp.fun;
+#ifndef Q_UNSAFE
+        // establish stable state configuration
+        me->temp.uint = QP_DIS_UPDATE(uintptr_t, me->state.uint);
+#endif
+        return;
+    }
+#endif // def QACTIVE_SNAPSHOT
+
     // the top-most initial tran. must be taken
     Q_ASSERT_LOCAL(240, r == Q_RET_TRAN);
 
@@ -219,7 +271,7 @@ void QHsm_init_(QAsm * const me,
         ++ip;
 
         // find the superstate of 'm_temp.fun', ignore result
-        (void)(*me->temp.fun)(me, &l_resEvt_[Q_EMPTY_SIG]);
+        (void)QHSM_SUPER_(me, me->temp.fun);
     } while (me->temp.fun != s);
 
     // enter the target (possibly recursively) by initial trans.
@@ -227,6 +279,21 @@ void QHsm_init_(QAsm * const me,
 
     QS_TOP_INIT_(QS_QEP_INIT_TRAN, path[0]); // output QS record
 
+#ifndef Q_UNSAFE
+    // check the nesting depth of the initial state configuration
+    // up front, before the first event is dispatched, see NOTE3
+    me->temp.fun = path[0];
+    ip = 1U; // nesting depth (the top state included) & fixed loop bound
+    do {
+        // the nesting depth must not exceed QHSM_MAX_NEST_DEPTH
+        Q_INVARIANT_LOCAL(280, ip < QHSM_MAX_NEST_DEPTH_);
+
+        ++ip;
+        // find the superstate of 'temp.fun', ignore result
+        (void)QHSM_SUPER_(me, me->temp.fun);
+    } while (me->temp.fun != Q_STATE_CAST(&QHsm_top));
+#endif // ndef Q_UNSAFE
+
     me->state.fun = path[0]; // change the current active state
 #ifndef Q_UNSAFE
     // establish stable state configuration
@@ -263,6 +330,12 @@ void QHsm_dispatch_(QAsm * const me,
     QS_CRIT_STAT
     QS_TRAN0_(QS_QEP_DISPATCH, s); // output QS record
 
+#ifdef QASM_PROFILE
+    QStateHandler hops[QHSM_MAX_NEST_DEPTH_]; // states passing the event
+    uint_fast8_t nHops = 0U;
+    uint32_t const start = QF_onGetTime(); // start of the RTC step
+#endif
+
     // process the event hierarchically...
     QStateHandler path[QHSM_MAX_NEST_DEPTH_]; // entry path array
     me->temp.fun = s;
@@ -282,8 +355,14 @@ void QHsm_dispatch_(QAsm * const me,
             QS_TRAN_ACT_(QS_QEP_UNHANDLED, s); // output QS record
 
             // find the superstate of 's'
-            r = (*s)(me, &l_resEvt_[Q_EMPTY_SIG]);
+            r = QHSM_SUPER_(me, s);
+        }
+#ifdef QASM_PROFILE
+        if (r == Q_RET_SUPER) { // event passed to the superstate?
+            hops[nHops] = s; // recorded at the end, see NOTE6
+            ++nHops;
         }
+#endif
     } while (r == Q_RET_SUPER); // loop as long as superstate returned
 
     // me->state should not change, so it must match the saved DIS
@@ -318,10 +397,14 @@ void QHsm_dispatch_(QAsm * const me,
         path[2] = s; // save tran. source in path[2]
 
         // take the tran...
+#ifdef QHSM_CACHE
+        ip = QHsm_tran_cached_(me, path, qsId); // see NOTE2
+#else
         ip = QHsm_tran_simple_(me, path, qsId); // try simple tran. first
         if (ip > 1U) { // not a simple tran.?
             ip = QHsm_tran_complex_(me, path, qsId);
         }
+#endif // def QHSM_CACHE
 
         // enter the target (possibly recursively) by initial trans.
         QHsm_enter_target_(me, path, ip, qsId);
@@ -333,6 +416,11 @@ void QHsm_dispatch_(QAsm * const me,
         Q_ERROR_LOCAL(370); // last state handler returned impossible value
     }
 
+#ifdef QASM_PROFILE
+    // the RTC step completed in 's' (QHsm_top for the ignored events)
+    QAsm_profRecord_(hops, nHops, s, r, QF_onGetTime() - start);
+#endif
+
 #ifndef Q_UNSAFE
     // establish "stable state configuration"
     me->temp.uint = QP_DIS_UPDATE(uintptr_t, me->state.uint);
@@ -364,7 +452,7 @@ size_t QHsm_tran_simple_(
     }
     else { // not a tran. to self
         // find superstate of target in 't'
-        QState const r = (*t)(me, &l_resEvt_[Q_EMPTY_SIG]);
+        QState const r = QHSM_SUPER_(me, t);
 
         // state handler t must return the superstate for Q_EMPTY_SIG
         Q_ASSERT_LOCAL(440, r == Q_RET_SUPER);
@@ -379,7 +467,7 @@ size_t QHsm_tran_simple_(
         t = me->temp.fun;
         if (s != t) {
             // find superstate of source 's', ignore the result
-            (void)(*s)(me, &l_resEvt_[Q_EMPTY_SIG]);
+            (void)QHSM_SUPER_(me, s);
 
             // (c) check source->super==target->super...
             if (me->temp.fun == t) {
@@ -434,7 +522,7 @@ size_t QHsm_tran_complex_(QAsm * const me,
         ++ip;
 
         // find superstate of 'm_temp.fun'
-        r = (*me->temp.fun)(me, &l_resEvt_[Q_EMPTY_SIG]);
+        r = QHSM_SUPER_(me, me->temp.fun);
         if (me->temp.fun == s) { // is temp the LCA?
             iq = 1U; // indicate that LCA is found
             break;
@@ -476,7 +564,7 @@ size_t QHsm_tran_complex_(QAsm * const me,
                 if ((*s)(me, &l_resEvt_[Q_EXIT_SIG]) == Q_RET_HANDLED) {
                     QS_STATE_ACT_(QS_QEP_STATE_EXIT, s);
                     // find superstate of 's', ignore the result
-                    (void)(*s)(me, &l_resEvt_[Q_EMPTY_SIG]);
+                    (void)QHSM_SUPER_(me, s);
                 }
                 s = me->temp.fun; // set to super of s
                 // NOTE: loop bounded per invariant:540
@@ -541,7 +629,7 @@ void QHsm_enter_target_(QAsm * const me,
             ++ip;
 
             // find superstate of 'temp.fun'
-            QState const r = (*me->temp.fun)(me, &l_resEvt_[Q_EMPTY_SIG]);
+            QState const r = QHSM_SUPER_(me, me->temp.fun);
 
             // the temp superstate handler must return superstate
             Q_ASSERT_LOCAL(680, r == Q_RET_SUPER);
@@ -573,20 +661,56 @@ bool QHsm_isIn_(QAsm * const me,
         QP_DIS_VERIFY(uintptr_t, me->state.uint, me->temp.uint));
 
     bool inState = false; // assume that this HSM is NOT in 'stateHndl'
-
-    // scan the state hierarchy bottom-up
+    bool isDone = false;  // assume that the full scan is needed
     QStateHandler s = me->state.fun;
-    QState r;
-    do {
-        if (s == stateHndl) { // do the states match?
-            inState = true;  // 'true' means that match found
-            break; // break out of the do-loop
+
+#ifdef QHSM_CACHE
+    QHsmCache const * const cache = me->cache;
+    if (cache != (QHsmCache *)0) { // superstate cache attached?
+        QHsmSuper const *cs = QHsmCache_find_(cache, s);
+        if (cs == (QHsmSuper *)0) { // current state not cached yet?
+            (void)QHSM_SUPER_(me, s); // cache 's' with all its superstates
+            cs = QHsmCache_find_(cache, s);
+        }
+        QHsmSuper const * const ct = QHsmCache_find_(cache, stateHndl);
+        if ((cs != (QHsmSuper *)0) && (ct != (QHsmSuper *)0)) {
+#ifdef QASM_ANCESTRY
+            if ((cs->index < QASM_ANCESTRY_BITS)
+                && (ct->index < QASM_ANCESTRY_BITS))
+            {
+                // single bit test in the ancestry of 's', see NOTE4
+                inState = (((cs->ancestry >> ct->index) & 1U) != 0U);
+                isDone = true;
+            }
+#endif // def QASM_ANCESTRY
+            if (!isDone) {
+                // climb straight to the nesting depth of 'stateHndl',
+                // see NOTE1
+                for (uint_fast8_t d = cs->depth; d > ct->depth; --d) {
+                    (void)QHSM_SUPER_(me, s);
+                    s = me->temp.fun;
+                }
+                inState = (s == stateHndl);
+                isDone = true;
+            }
         }
+    }
+#endif // def QHSM_CACHE
 
-        // find superstate of 's'
-        r = (*s)(me, &l_resEvt_[Q_EMPTY_SIG]);
-        s = me->temp.fun;
-    } while (r == Q_RET_SUPER);
+    if (!isDone) {
+        // scan the state hierarchy bottom-up
+        QState r;
+        do {
+            if (s == stateHndl) { // do the states match?
+                inState = true;  // 'true' means that match found
+                break; // break out of the do-loop
+            }
+
+            // find superstate of 's'
+            r = QHSM_SUPER_(me, s);
+            s = me->temp.fun;
+        } while (r == Q_RET_SUPER);
+    }
 
 #ifndef Q_UNSAFE
     // restore the invariant (stable state configuration)
@@ -622,7 +746,7 @@ QStateHandler QHsm_childState(QHsm * const me,
         child = me->super.temp.fun;
 
         // find superstate of 'child' (placed in me->super.temp)
-        r = (*child)(me, &l_resEvt_[Q_EMPTY_SIG]);
+        r = QHSM_SUPER_(&me->super, child);
     } while (r == Q_RET_SUPER);
     Q_ENSURE_LOCAL(890, isFound);
 
@@ -644,3 +768,508 @@ QStateHandler QHsm_getStateHandler_(QAsm const * const me) {
     // be safely called from an already established critical section.
     return me->state.fun;
 }
+
+#ifdef QHSM_CACHE
+//............................................................................
+//! @public @memberof QHsmCache
+void QHsmCache_ctor(QHsmCache * const me,
+    QHsmSuper * const superSto,
+    uint_fast16_t const superLen)
+{
+    // the storage must be provided and its length must be a power of 2
+    Q_REQUIRE_LOCAL(900, (superSto != (QHsmSuper *)0)
+        && (0U < superLen) && (superLen <= 0x8000U)
+        && ((superLen & (superLen - 1U)) == 0U));
+
+    for (uint_fast16_t i = 0U; i < superLen; ++i) {
+        superSto[i].state = Q_STATE_CAST(0); // the entry is free
+        superSto[i].super = Q_STATE_CAST(0);
+        superSto[i].depth = 0U;
+#ifdef QASM_ANCESTRY
+        superSto[i].ancestry = 0U;
+        superSto[i].index    = 0xFFU; // no index assigned
+#endif
+    }
+    me->superSto  = superSto;
+    me->superMask = (uint16_t)(superLen - 1U);
+    me->tranSto   = (QHsmTran *)0; // no transition cache by default
+    me->tranMask  = 0U;
+#ifdef QASM_ANCESTRY
+    me->nIndex    = 0U; // no state indexes assigned yet
+#endif
+}
+
+//............................................................................
+//! @public @memberof QHsmCache
+void QHsmCache_initTran(QHsmCache * const me,
+    QHsmTran * const tranSto,
+    uint_fast16_t const tranLen)
+{
+    // the storage must be provided and its length must be a power of 2
+    Q_REQUIRE_LOCAL(930, (tranSto != (QHsmTran *)0)
+        && (0U < tranLen) && (tranLen <= 0x8000U)
+        && ((tranLen & (tranLen - 1U)) == 0U));
+
+    for (uint_fast16_t i = 0U; i < tranLen; ++i) {
+        tranSto[i].source = Q_STATE_CAST(0); // the entry is free
+        tranSto[i].target = Q_STATE_CAST(0);
+        tranSto[i].nExit  = 0U;
+        tranSto[i].nEntry = 0U;
+    }
+    me->tranSto  = tranSto;
+    me->tranMask = (uint16_t)(tranLen - 1U);
+}
+
+//............................................................................
+//! @public @memberof QHsm
+void QHsm_setCache(QHsm * const me,
+    QHsmCache * const cache)
+{
+    // the cache can be attached only before the top-most initial tran.
+    Q_REQUIRE_LOCAL(910, me->super.state.fun == Q_STATE_CAST(&QHsm_top));
+
+    me->super.cache = cache; // NULL detaches the cache
+}
+
+//............................................................................
+//! @private @memberof QHsm
+static QState QHsm_super_(QAsm * const me,
+    QStateHandler const s)
+{
+    QHsmCache * const cache = me->cache;
+    if ((cache == (QHsmCache *)0) || (s == Q_STATE_CAST(&QHsm_top))) {
+        return (*s)(me, &l_resEvt_[Q_EMPTY_SIG]); // no caching
+    }
+
+    QHsmSuper const *ent = QHsmCache_find_(cache, s);
+    if (ent != (QHsmSuper *)0) { // cache hit?
+        me->temp.fun = ent->super;
+        return Q_RET_SUPER;
+    }
+
+    // cache miss: discover the superstates of 's' up to the first cached
+    // one (or the top) by calling the state handlers, see NOTE1
+    QState r = (*s)(me, &l_resEvt_[Q_EMPTY_SIG]);
+    if (r != Q_RET_SUPER) { // 's' did not provide its superstate?
+        return r; // return it unchanged (nothing cached)
+    }
+    QStateHandler const sup = me->temp.fun; // the superstate of 's'
+
+    QStateHandler chain[QHSM_MAX_NEST_DEPTH_];
+    chain[0] = s;
+    size_t n = 1U; // # states in chain[] & fixed loop bound
+    QStateHandler t = sup; // the superstate of chain[n - 1U]
+    uint_fast8_t depth = 0U; // nesting depth of 't'
+    while (t != Q_STATE_CAST(&QHsm_top)) {
+        ent = QHsmCache_find_(cache, t);
+        if (ent != (QHsmSuper *)0) { // cached superstate reached?
+            depth = ent->depth;
+            break;
+        }
+
+        // the chain must not exceed the maximum nesting depth
+        Q_INVARIANT_LOCAL(920, n < QHSM_MAX_NEST_DEPTH_);
+
+        r = (*t)(me, &l_resEvt_[Q_EMPTY_SIG]);
+        if (r != Q_RET_SUPER) { // hierarchy could not be discovered?
+            n = 0U; // do not cache the incomplete chain
+            break;
+        }
+        chain[n] = t;
+        ++n;
+        t = me->temp.fun;
+    }
+
+    // insert the discovered states top-down, so that each state gets
+    // the nesting depth of its superstate plus one
+    for (; n > 0U; --n) {
+        ++depth;
+        QHsmCache_insert_(cache, chain[n - 1U], t, depth);
+        t = chain[n - 1U]; // the superstate of the next state in chain[]
+    }
+
+    me->temp.fun = sup; // like the state handler, provide the superstate
+    return Q_RET_SUPER;
+}
+
+//............................................................................
+//! @private @memberof QHsmCache
+static QHsmSuper const * QHsmCache_find_(QHsmCache const * const me,
+    QStateHandler const s)
+{
+    uint_fast16_t const mask = me->superMask;
+    uint_fast16_t i = QHsmCache_hash_(s) & mask;
+
+    // NOTE: the linear probing is bounded by the number of entries
+    for (uint_fast16_t k = mask + 1U; k > 0U; --k) {
+        QHsmSuper const * const ent = &me->superSto[i];
+        // the entry is published by its state, see NOTE1
+        QStateHandler const state = QHSM_CACHE_LOAD_ACQ_(ent->state);
+        if (state == s) { // found?
+            return ent;
+        }
+        if (state == Q_STATE_CAST(0)) { // free entry ends the probe
+            break;
+        }
+        i = (i + 1U) & mask;
+    }
+    return (QHsmSuper *)0; // not cached
+}
+
+//............................................................................
+//! @private @memberof QHsmCache
+static void QHsmCache_insert_(QHsmCache * const me,
+    QStateHandler const s,
+    QStateHandler const super,
+    uint_fast8_t const depth)
+{
+    uint_fast16_t const mask = me->superMask;
+    uint_fast16_t i = QHsmCache_hash_(s) & mask;
+
+    // the entries are claimed and filled in a critical section, so that
+    // the instances sharing the cache can insert concurrently, see NOTE1
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // NOTE: the linear probing is bounded by the number of entries
+    for (uint_fast16_t k = mask + 1U; k > 0U; --k) {
+        QHsmSuper * const ent = &me->superSto[i];
+        if (ent->state == Q_STATE_CAST(0)) { // free entry?
+            ent->super = super;
+            ent->depth = (uint8_t)depth;
+#ifdef QASM_ANCESTRY
+            // assign the next index, if the superstate is indexed as well
+            // (the superstates are always inserted first), see NOTE4
+            QHsmSuper const * const sup = QHsmCache_find_(me, super);
+            bool const isSupIndexed = (sup != (QHsmSuper *)0)
+                ? (sup->index < QASM_ANCESTRY_BITS)
+                : (super == Q_STATE_CAST(&QHsm_top));
+            if (isSupIndexed && (me->nIndex < QASM_ANCESTRY_BITS)) {
+                ent->index    = me->nIndex;
+                ent->ancestry = ((uint32_t)1U << me->nIndex)
+                    | ((sup != (QHsmSuper *)0) ? sup->ancestry : 0U);
+                ++me->nIndex;
+            }
+#endif // def QASM_ANCESTRY
+            QHSM_CACHE_STORE_REL_(ent->state, s); // publish the entry
+            break;
+        }
+        if (ent->state == s) { // already cached?
+            break;
+        }
+        i = (i + 1U) & mask;
+    }
+
+    QF_CRIT_EXIT();
+
+    // NOTE: the state is not cached when the table is full, which is
+    // benign, because QHsm_super_() then falls back to the state handler
+}
+
+//............................................................................
+//! @private @memberof QHsm
+static size_t QHsm_tran_cached_(QAsm * const me,
+    QStateHandler * const path,
+    uint_fast8_t const qsId)
+{
+    QHsmCache * const cache = me->cache;
+    if ((cache == (QHsmCache *)0) || (cache->tranSto == (QHsmTran *)0)) {
+        size_t ip = QHsm_tran_simple_(me, path, qsId); // try simple first
+        if (ip > 1U) { // not a simple tran.?
+            ip = QHsm_tran_complex_(me, path, qsId);
+        }
+        return ip;
+    }
+
+    QStateHandler const s = path[2]; // source
+    QStateHandler const t = path[0]; // target
+
+    // find the transition or the free entry for it
+    uint_fast16_t const mask = cache->tranMask;
+    uint_fast16_t i = (QHsmCache_hash_(s) ^ (QHsmCache_hash_(t) << 1U))
+                      & mask;
+    QHsmTran *ent = (QHsmTran *)0;
+    bool isHit = false;
+    // NOTE: the linear probing is bounded by the number of entries
+    for (uint_fast16_t k = mask + 1U; k > 0U; --k) {
+        QHsmTran * const slot = &cache->tranSto[i];
+        // the entry is published by its source, see NOTE2
+        QStateHandler const source = QHSM_CACHE_LOAD_ACQ_(slot->source);
+        if (source == Q_STATE_CAST(0)) { // free entry?
+            ent = slot;
+            break;
+        }
+        if ((source == s) && (slot->target == t)) { // cached?
+            ent = slot;
+            isHit = true;
+            break;
+        }
+        i = (i + 1U) & mask;
+    }
+
+    if (isHit) { // cache hit?
+        QS_CRIT_STAT
+
+        // exit the source and its superstates below the LCA
+        QStateHandler x = s;
+        for (uint_fast8_t n = ent->nExit; n > 0U; --n) {
+            if ((*x)(me, &l_resEvt_[Q_EXIT_SIG]) == Q_RET_HANDLED) {
+                QS_STATE_ACT_(QS_QEP_STATE_EXIT, x); // output QS record
+                if (n > 1U) { // more states to exit?
+                    (void)QHSM_SUPER_(me, x); // find superstate of 'x'
+                }
+            }
+            x = me->temp.fun; // set to super of 'x'
+        }
+
+        // restore the entry path for QHsm_enter_target_()
+        size_t const ip = ent->nEntry;
+        for (size_t iq = 0U; iq < ip; ++iq) {
+            path[iq] = ent->entry[iq];
+        }
+        return ip;
+    }
+
+    // cache miss: take the tran. in the regular way...
+    size_t ip = QHsm_tran_simple_(me, path, qsId); // try simple tran. first
+    if (ip > 1U) { // not a simple tran.?
+        ip = QHsm_tran_complex_(me, path, qsId);
+    }
+
+    if (ent != (QHsmTran *)0) { // free entry available?
+        // the LCA is the superstate of the last entered state
+        // or the target itself when nothing is entered (source->super)
+        QStateHandler lca = t;
+        if (ip > 0U) {
+            (void)QHSM_SUPER_(me, path[ip - 1U]);
+            lca = me->temp.fun;
+        }
+
+        // count the exited states from the source up to the LCA
+        QStateHandler x = s;
+        uint_fast8_t n = 0U; // # exited states & fixed loop bound
+        while (x != lca) {
+            // the exit path must not exceed the maximum nesting depth
+            Q_INVARIANT_LOCAL(940, n < QHSM_MAX_NEST_DEPTH_);
+
+            (void)QHSM_SUPER_(me, x);
+            x = me->temp.fun;
+            ++n;
+        }
+
+        // claim and fill the entry in a critical section, unless another
+        // instance sharing the cache has claimed it meanwhile, see NOTE2
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        if (ent->source == Q_STATE_CAST(0)) { // still free?
+            for (size_t iq = 0U; iq < ip; ++iq) {
+                ent->entry[iq] = path[iq];
+            }
+            ent->nEntry = (uint8_t)ip;
+            ent->nExit  = (uint8_t)n;
+            ent->target = t;
+            QHSM_CACHE_STORE_REL_(ent->source, s); // publish the entry
+        }
+        QF_CRIT_EXIT();
+    }
+    return ip;
+}
+#endif // def QHSM_CACHE
+
+#if (defined QHSM_CACHE) || (defined QASM_PROFILE)
+//............................................................................
+//! @private @memberof QHsmCache
+static uint_fast16_t QHsmCache_hash_(QStateHandler const s) {
+    union QAsmAttr key;
+    key.fun = s;
+    // NOTE: the low bits of code addresses are mostly aligned (zero)
+    return (uint_fast16_t)((key.uint >> 2U) ^ (key.uint >> 9U));
+}
+#endif // (defined QHSM_CACHE) || (defined QASM_PROFILE)
+
+#ifdef QASM_PROFILE
+//............................................................................
+//! @static @public @memberof QAsm
+bool QAsm_getProfile(uint_fast16_t const idx,
+    QAsmProfile * const prof,
+    bool const reset)
+{
+    // the index must be in range and the profile must be provided
+    Q_REQUIRE_LOCAL(1000, (idx < QASM_PROFILE)
+                          && (prof != (QAsmProfile *)0));
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY(); // consistent copy (and reset), see NOTE6
+
+    QAsmProfile * const p = &l_profile_[idx];
+    *prof = *p;
+    if (reset) { // reset the counters? (the state keeps its entry)
+        p->nHandled   = 0U;
+        p->nUnhandled = 0U;
+        p->nTran      = 0U;
+        p->time       = 0U;
+    }
+
+    QF_CRIT_EXIT();
+
+    return prof->state != Q_STATE_CAST(0); // is the entry used?
+}
+
+//............................................................................
+//! @static @private @memberof QAsm
+void QAsm_profRecord_(QStateHandler const hops[],
+    uint_fast8_t const nHops,
+    QStateHandler const state,
+    QState const r,
+    uint32_t const time)
+{
+    // the whole RTC step is recorded in one critical section, see NOTE6
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the states that passed the event to their superstates
+    for (uint_fast8_t h = 0U; h < nHops; ++h) {
+        QAsmProfile * const prof = QAsm_profFind_(hops[h]);
+        if (prof != (QAsmProfile *)0) { // the table not full?
+            ++prof->nUnhandled;
+        }
+    }
+
+    // the state that completed the RTC step
+    QAsmProfile * const prof = QAsm_profFind_(state);
+    if (prof != (QAsmProfile *)0) { // the table not full?
+        if (r == Q_RET_HANDLED) {
+            ++prof->nHandled;
+        }
+        else if ((r == Q_RET_TRAN) || (r == Q_RET_TRAN_HIST)) {
+            ++prof->nTran;
+        }
+        else { // ignored
+            ++prof->nUnhandled;
+        }
+        prof->time += time;
+    }
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @static @private @memberof QAsm
+static QAsmProfile * QAsm_profFind_(QStateHandler const state) {
+    // NOTE: must be called inside a critical section
+    uint_fast16_t const mask = QASM_PROFILE - 1U;
+    uint_fast16_t i = QHsmCache_hash_(state) & mask;
+    QAsmProfile *prof = (QAsmProfile *)0;
+    for (uint_fast16_t n = 0U; n < QASM_PROFILE; ++n) { // bounded probing
+        QAsmProfile * const p = &l_profile_[i];
+        if (p->state == state) { // profile of the state found?
+            prof = p;
+            break;
+        }
+        if (p->state == Q_STATE_CAST(0)) { // free entry?
+            p->state = state; // claim the entry for the state
+            prof = p;
+            break;
+        }
+        i = (i + 1U) & mask;
+    }
+    return prof; // NULL if the table is full
+}
+#endif // def QASM_PROFILE
+
+//============================================================================
+// NOTE1:
+// The superstate cache (QHSM_CACHE) replaces the calls of state handlers
+// with the reserved Q_EMPTY_SIG ("what is your superstate?") by lookups in
+// a small open-addressing hash table, which also remembers the nesting
+// depth of each state. The state hierarchy is discovered lazily by calling
+// the state handlers on the first miss, so the cache needs no code
+// generation and applies to any QHsm. The discovery stops at the first
+// cached ancestor, so every state handler is probed at most once per cache.
+// The exit/entry/initial transitions are still executed by calling the
+// state handlers in exactly the same order, so the behavior of the state
+// machine does not depend on the cache. Only the superstate probes (which
+// must not have side effects) are avoided. QHsm_isIn_() uses the depths
+// to return early when the given state is nested deeper than the current
+// state and otherwise climbs straight to the depth of the given state.
+//
+// A cache can be shared by all instances of the same QHsm subclass, also
+// when those instances are dispatched in different threads. The entries
+// are only ever added (never changed or removed). A new entry is claimed
+// and filled in a critical section (which is taken only on a cache miss)
+// and is published by storing its state last with the release semantics
+// (QHSM_CACHE_STORE_REL_()). The lookups run without a critical section
+// and read the state with the acquire semantics (QHSM_CACHE_LOAD_ACQ_()),
+// so a thread that finds a state also sees the complete entry. A full
+// cache is benign (the misses simply call the state handlers), but the
+// cache should be sized to at least twice the number of states to keep
+// the probe sequences short.
+//
+// NOTE2:
+// The transition cache (see QHsmCache_initTran()) remembers the outcome of
+// QHsm_tran_simple_()/QHsm_tran_complex_() for each pair of the transition
+// source and target, which never changes, because the state hierarchy is
+// fixed. The cached entry holds the number of states to exit (starting
+// from the source) and the entry path from the LCA down to the target. A
+// repeated transition exits and enters the same states in the same order
+// as the regular algorithm, but without searching for the LCA. The nested
+// initial transitions in the target are not cached, because they can
+// depend on guards, so QHsm_enter_target_() drills into the target as
+// before. A full transition cache is benign (the misses take the regular
+// path). Like in NOTE1, the entries are claimed and filled in a critical
+// section and are published by their source. An entry claimed meanwhile
+// by another thread (possibly for a different transition) is left alone
+// and the transition is simply not cached.
+//
+// NOTE3:
+// The maximum nesting depth is a build-time setting (QHSM_MAX_NEST_DEPTH),
+// because it sizes the entry path array that every dispatch keeps on the
+// stack (no allocation and no variable-length arrays). Only one such array
+// exists per dispatch, because QHsm_tran_complex_() and
+// QHsm_enter_target_() work in the array of QHsm_dispatch_(). The loops
+// over the state hierarchy remain bounded by the same constant. The depth
+// of the initial state configuration is checked in QHsm_init_(), so that
+// a model nested too deeply fails at initialization rather than at the
+// first event. Deeper states entered later are still caught by the
+// invariants in QHsm_dispatch_() and QHsm_enter_target_().
+//
+// NOTE4:
+// With QASM_ANCESTRY, the states cached in a QHsmCache are assigned
+// compact indexes (in the order of discovery) and the ancestry bitsets,
+// which hold the bits of the state and all its superstates. The bitsets
+// depend only on the state hierarchy, so they stay valid for all
+// instances and all state changes, and QHsm_isIn_() becomes a single bit
+// test. A state gets an index only when its superstate has one (or is the
+// top), so at most QASM_ANCESTRY_BITS states of a class are indexed; the
+// remaining states use the depth-based climb from NOTE1.
+//
+// NOTE5:
+// The top-most initial tran. of an active object can restore the state
+// saved in a snapshot (see QActive_restore()), which sets the restored
+// state in temp and returns Q_RET_RESTORE. The restored state becomes the
+// current state directly, without executing any entry actions or initial
+// transitions, because the side effects of the original entry into that
+// state configuration are either still in place or are restored by the
+// application together with its snapshot data.
+//
+// NOTE6:
+// With QASM_PROFILE, QHsm_dispatch_() and QMsm_dispatch_() record the
+// dispatch profile of every state handler involved in an RTC step in a
+// fixed table of QASM_PROFILE entries, keyed by the state handler (so the
+// profile of a state covers all instances of the state machine class).
+// A state that passes the event to its superstate counts as unhandled,
+// and the state that completes the RTC step counts the handled event or
+// the taken transition together with the duration of the whole RTC step
+// (including the exit and entry actions of the transition), measured with
+// QF_onGetTime(), which can return any free-running cycle counter. The
+// ignored events are attributed to QHsm_top (also for QMsm). The states
+// that do not fit in a full table are not profiled. The table is shared by
+// all threads, so the entries are claimed and updated in a critical
+// section, which keeps the counts exact also for the state machines of the
+// same class running at different preemption priorities. The states that
+// pass the event to their superstates are collected in a local array
+// during the RTC step and are recorded together with the state that
+// completes the step in a single critical section at the end, so the
+// profiling costs one critical section per dispatch (outside the measured
+// time of the step). The profiles are read out by QAsm_getProfile(), entry
+// by entry, also in a critical section.
@@ -40,7 +40,7 @@
 Q_DEFINE_THIS_MODULE("qep_msm")
 
 // maximum depth of state nesting in a QMsm (including the top level)
-#define QMSM_MAX_NEST_DEPTH_  ((size_t)6U)
+#define QMSM_MAX_NEST_DEPTH_  ((size_t)QHSM_MAX_NEST_DEPTH)
 
 //! @cond INTERNAL
 
@@ -51,6 +51,13 @@ static struct QMState const l_msm_top_s = {
     Q_ACTION_CAST(0),
     Q_ACTION_CAST(0),
     Q_ACTION_CAST(0)
+#ifdef QMSM_SIG_MAP
+    , (struct QMSigAct *)0
+#endif
+#ifdef QASM_ANCESTRY
+    , 0U    // no ancestry bitset
+    , 0xFFU // no index
+#endif
 };
 
 #ifdef Q_SPY
@@ -124,6 +131,13 @@ static QState QMsm_execTatbl_(
     QMTranActTable const * const tatbl,
     uint_fast8_t const qsId);
 
+#ifdef QMSM_SIG_MAP
+static QState QMsm_mapSig_(
+    QAsm * const me,
+    QMState const * const s,
+    QEvt const * const e);
+#endif
+
 static void QMsm_exitToTranSource_(
     QAsm * const me,
     QMState const * const curr_state,
@@ -172,6 +186,26 @@ void QMsm_init_(
     // execute the top-most initial tran.
     QState r = (*me->temp.fun)(me, Q_EVT_CAST(QEvt));
 
+#ifdef QACTIVE_SNAPSHOT
+    if (r == Q_RET_RESTORE) { // state restored from a snapshot? see NOTE3
+        // the restored state must be set in temp
+        Q_ASSERT_LOCAL(220, me->temp.obj != (struct QMState *)0);
+
+        QS_CRIT_STAT
+        QS_TRAN_SEG_(QS_QEP_STATE_INIT,
+           me->state.obj->stateHandler, me->temp.obj->stateHandler);
+        QS_TOP_INIT_(QS_QEP_INIT_TRAN, me->temp.obj->stateHandler);
+
+        // no entry actions and no initial transitions
+        me->state.obj = me->temp.obj;
+#ifndef Q_UNSAFE
+        // establish stable state configuration
+        me->temp.uint = QP_DIS_UPDATE(uintptr_t, me->state.uint);
+#endif
+        return;
+    }
+#endif // def QACTIVE_SNAPSHOT
+
     // the top-most initial tran. must be taken
     Q_ASSERT_LOCAL(240, r == Q_RET_TRAN_INIT);
 
@@ -222,10 +256,25 @@ void QMsm_dispatch_(
     QS_CRIT_STAT
     QS_TRAN0_(QS_QEP_DISPATCH, s->stateHandler);
 
+#ifdef QASM_PROFILE
+    QStateHandler hops[QHSM_MAX_NEST_DEPTH_]; // states passing the event
+    uint_fast8_t nHops = 0U;
+    uint32_t const start = QF_onGetTime(); // start of the RTC step
+#endif
+
     // scan the state hierarchy up to the top state...
     QState r;
     do {
+#ifdef QMSM_SIG_MAP
+        if (s->sigMap != (struct QMSigAct *)0) { // signal map provided?
+            r = QMsm_mapSig_(me, s, e); // see NOTE1
+        }
+        else {
+            r = (*s->stateHandler)(me, e); // call state handler function
+        }
+#else
         r = (*s->stateHandler)(me, e); // call state handler function
+#endif // def QMSM_SIG_MAP
         if (r >= Q_RET_HANDLED) { // event handled? (the most frequent case)
             break; // done scanning the state hierarchy
         }
@@ -239,11 +288,26 @@ void QMsm_dispatch_(
             QS_END_PRE()
             QS_CRIT_EXIT();
         }
+#endif
+#ifdef QASM_PROFILE
+        // record at the end (the hops beyond the array are not profiled)
+        if (nHops < QHSM_MAX_NEST_DEPTH_) { // see NOTE6 in qep_hsm.c
+            hops[nHops] = s->stateHandler;
+            ++nHops;
+        }
 #endif
         s = s->superstate; // advance to the superstate
 
     } while (s != (QMState *)0);
 
+#ifdef QASM_PROFILE
+    // the RTC step completes in 's' (QHsm_top for the ignored events)
+    // NOTE: 's' and 'r' can change in the tran. below
+    QStateHandler const profState = (s != (QMState *)0)
+        ? s->stateHandler : Q_STATE_CAST(&QHsm_top);
+    QState const profRet = (s != (QMState *)0) ? r : Q_RET_IGNORED;
+#endif
+
     if (s == (QMState *)0) { // event bubbled to the 'top' state?
 #ifdef Q_SPY
         QS_TRAN0_(QS_QEP_IGNORED, t->stateHandler);
@@ -294,12 +358,50 @@ void QMsm_dispatch_(
         Q_ERROR_LOCAL(360); // last action handler returned impossible value
     }
 
+#ifdef QASM_PROFILE
+    // see NOTE6 in qep_hsm.c
+    QAsm_profRecord_(hops, nHops, profState, profRet,
+                     QF_onGetTime() - start);
+#endif
+
 #ifndef Q_UNSAFE
     // establish stable state configuration at the end of RTC step
     me->temp.uint = QP_DIS_UPDATE(uintptr_t, me->state.uint);
 #endif
 }
 
+#ifdef QMSM_SIG_MAP
+//............................................................................
+//! @private @memberof QMsm
+static QState QMsm_mapSig_(
+    QAsm * const me,
+    QMState const * const s,
+    QEvt const * const e)
+{
+    QSignal const sig = e->sig;
+    QState r = Q_RET_SUPER; // assume that 's' does not handle the signal
+
+    // the map is sorted by signal and ends with QM_SIG_MAP_END (signal 0)
+    QMSigAct const *a = s->sigMap;
+    while (a->sig != (QSignal)0U) {
+        if (a->sig >= sig) { // signal reached or passed?
+            if (a->sig == sig) { // signal handled in 's'?
+                if (a->tatbl != (struct QMTranActTable *)0) {
+                    me->temp.tatbl = a->tatbl; // unconditional tran.
+                    r = Q_RET_TRAN;
+                }
+                else { // guards or actions: the state handler decides
+                    r = (*s->stateHandler)(me, e);
+                }
+            }
+            break;
+        }
+        ++a;
+    }
+    return r;
+}
+#endif // def QMSM_SIG_MAP
+
 //............................................................................
 //! @private @memberof QMsm
 static QState QMsm_execTatbl_(
@@ -439,6 +541,34 @@ bool QMsm_isIn_(QAsm * const me, QStateHandler const stateHndl) {
     return inState;
 }
 
+#ifdef QASM_ANCESTRY
+//............................................................................
+//! @public @memberof QMsm
+bool QMsm_isInState(QMsm const * const me,
+    QMState const * const state)
+{
+    bool inState = false; // assume that this SM is not in 'state'
+    QMState const *s = me->super.state.obj;
+    if ((s->ancestry != 0U) && (state->ancestry != 0U)) { // bitsets given?
+        // the index must fit the ancestry bitsets
+        Q_REQUIRE_LOCAL(710, state->index < QASM_ANCESTRY_BITS);
+
+        // single bit test in the ancestry of the current state, see NOTE2
+        inState = (((s->ancestry >> state->index) & 1U) != 0U);
+    }
+    else { // scan the state hierarchy bottom-up
+        while (s != (QMState *)0) {
+            if (s == state) { // match found?
+                inState = true;
+                break;
+            }
+            s = s->superstate; // advance to the superstate
+        }
+    }
+    return inState;
+}
+#endif // def QASM_ANCESTRY
+
 //............................................................................
 //! @public @memberof QMsm
 QMState const * QMsm_childStateObj(
@@ -477,3 +607,49 @@ QStateHandler QMsm_getStateHandler_(QAsm const * const me) {
     // return the current state handler (function pointer)
     return me->state.obj->stateHandler;
 }
+
+//============================================================================
+// NOTE1:
+// The optional signal map (QMSM_SIG_MAP) of a QMState is a sparse list of
+// the signals handled in the state, generated from the model alongside
+// the QMState and QMTranActTable objects, for example:
+//
+// static QMSigAct const Blinky_off_map[] = {
+//     { TIMEOUT_SIG, &Blinky_off_tran_ },       // unconditional tran.
+//     { BUTTON_SIG,  (QMTranActTable *)0 },     // handled in Blinky_off()
+//     QM_SIG_MAP_END
+// };
+//
+// where the entries are sorted by signal. QMsm_dispatch_() skips the state handler
+// of a state whose map does not list the signal and goes directly to the
+// superstate. An unconditional transition without actions is taken
+// straight from the map, without calling the state handler. All other
+// listed signals are still delegated to the state handler, so the state
+// handlers and the tran-action tables remain the source of truth. The
+// states without a map (QM_SIG_MAP_NULL, or the initializers generated
+// without the map, e.g., with QMSTATE_INITIALIZER()) are dispatched
+// through the state handlers as before.
+// The map must list every signal the state handler handles, otherwise
+// the event is treated as unhandled in that state.
+//
+// NOTE2:
+// With QASM_ANCESTRY, the model generator assigns each QMState of a class
+// a compact index (0..QASM_ANCESTRY_BITS-1) and the ancestry bitset with
+// the bits of the state and all its superstates, for example:
+//
+// static QMState const Blinky_off_s = {
+//     &Blinky_active_s, ..., // the regular QMState members
+//     (1U << 1U) | (1U << 0U), 1U // ancestry & index of Blinky_off_s
+// };
+//
+// QMsm_isInState() is then a single bit test, because the bitsets depend
+// only on the state hierarchy. The states without the bitsets (zero
+// ancestry, e.g., generated without QASM_ANCESTRY) are checked by the
+// regular scan of the superstates.
+//
+// NOTE3:
+// The top-most initial tran. can restore the state saved in a snapshot
+// (see QActive_restore()) by setting the QMState object of the restored
+// state in temp and returning Q_RET_RESTORE. The restored state becomes
+// the current state without executing the entry actions or the initial
+// transitions (see also NOTE5 in qep_hsm.c).
@@ -45,6 +45,19 @@ static void QActive_postFIFO_(QActive * const me,
     QEvt const * const e,
     void const * const sender);
 
+#ifdef QACTIVE_LATENCY_BINS
+//! @private @memberof QActive
+static void QActive_latency_(QActive * const me, uint32_t const ts);
+#endif // def QACTIVE_LATENCY_BINS
+
+#ifdef QF_EQUEUE_SPSC
+//! @private @memberof QActive
+static bool QActive_postSPSC_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender);
+#endif // def QF_EQUEUE_SPSC
+
 //............................................................................
 //! @private @memberof QActive
 bool QActive_post_(QActive * const me,
@@ -60,6 +73,12 @@ bool QActive_post_(QActive * const me,
 #endif // (Q_UTEST != 0)
 #endif // def Q_UTEST
 
+#ifdef QF_EQUEUE_SPSC
+    if (me->eQueue.spsc != 0U) { // single-producer/single-consumer queue?
+        return QActive_postSPSC_(me, e, margin, sender);
+    }
+#endif // def QF_EQUEUE_SPSC
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -135,6 +154,11 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     // the event to post must be be valid (which includes not NULL)
     Q_REQUIRE_INCRIT(200, e != (QEvt *)0);
 
+#ifdef QF_EQUEUE_SPSC
+    // LIFO posting would make the AO a second producer to its own queue
+    Q_REQUIRE_INCRIT(210, me->eQueue.spsc == 0U);
+#endif
+
     QEQueueCtr nFree = me->eQueue.nFree; // get member into temporary
 
     // the queue must NOT overflow for the LIFO posting policy.
@@ -170,17 +194,18 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     }
 #endif // def Q_UTEST
 
-    QEvt const * const frontEvt = me->eQueue.frontEvt.e;
+    QEvtPtr const frontEvt = me->eQueue.frontEvt; // incl. timestamp
     me->eQueue.frontEvt.e = e; // deliver the event directly to the front
+    QACTIVE_EQUEUE_STAMP_(me->eQueue.frontEvt);
 
-    if (frontEvt != (QEvt *)0) { // was the queue NOT empty?
+    if (frontEvt.e != (QEvt *)0) { // was the queue NOT empty?
         QEQueueCtr tail = me->eQueue.tail; // get member into temporary
         ++tail;
         if (tail == me->eQueue.end) { // need to wrap the tail?
             tail = 0U; // wrap around
         }
         me->eQueue.tail = tail;
-        me->eQueue.ring[tail].e = frontEvt;
+        me->eQueue.ring[tail] = frontEvt;
     }
     else { // queue was empty
         QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
@@ -199,12 +224,63 @@ QEvt const * QActive_get_(QActive * const me) {
     // NOTE: might use assertion-IDs 400-409
     QACTIVE_EQUEUE_WAIT_(me);
 
+#ifdef QF_EQUEUE_SPSC
+    if (me->eQueue.spsc != 0U) { // single-producer/single-consumer queue?
+        // NOTE: the crit.sect. is needed only to synchronize the frontEvt
+        // indicator with the producer (see QActive_postSPSC_())
+#ifdef QACTIVE_LATENCY_BINS
+        uint32_t const ts = me->eQueue.ring[me->eQueue.tail].ts;
+#endif
+        QEvt const * const e = QEQueue_popSPSC_(&me->eQueue);
+
+        // the queue must NOT be empty
+        Q_REQUIRE_INCRIT(320, e != (QEvt *)0);
+
+#ifdef QACTIVE_LATENCY_BINS
+        QActive_latency_(me, ts);
+#endif
+
+        QF_SPSC_FENCE_(); // see NOTE1 in qf_qeq.c
+        me->eQueue.frontEvt.e = QEQueue_isEmpty(&me->eQueue)
+            ? (QEvt *)0 // queue becomes empty
+            : me->eQueue.ring[me->eQueue.tail].e; // next event in the queue
+
+#ifdef Q_SPY
+        if (me->eQueue.frontEvt.e != (QEvt *)0) { // more events?
+            QS_BEGIN_PRE(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE();       // timestamp
+                QS_SIG_PRE(e->sig);  // the signal of this event
+                QS_OBJ_PRE(me);      // this active object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE(QEQueue_getFree(&me->eQueue)); // # free entries
+            QS_END_PRE()
+        }
+        else {
+            QS_BEGIN_PRE(QS_QF_ACTIVE_GET_LAST, me->prio)
+                QS_TIME_PRE();       // timestamp
+                QS_SIG_PRE(e->sig);  // the signal of this event
+                QS_OBJ_PRE(me);      // this active object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_END_PRE()
+        }
+#endif // def Q_SPY
+
+        QF_CRIT_EXIT();
+
+        return e;
+    }
+#endif // def QF_EQUEUE_SPSC
+
     // always remove event from the front
     QEvt const * const e = me->eQueue.frontEvt.e;
 
     // the queue must NOT be empty
     Q_REQUIRE_INCRIT(310, e != (QEvt *)0);
 
+#ifdef QACTIVE_LATENCY_BINS
+    QActive_latency_(me, me->eQueue.frontEvt.ts);
+#endif
+
     QEQueueCtr nFree = me->eQueue.nFree; // get member into temporary
 
     ++nFree; // one more free event in the queue
@@ -228,7 +304,7 @@ QEvt const * QActive_get_(QActive * const me) {
             QS_EQC_PRE(nFree);   // # free entries
         QS_END_PRE()
 
-        me->eQueue.frontEvt.e = frontEvt; // update the original
+        me->eQueue.frontEvt = me->eQueue.ring[tail]; // incl. timestamp
         if (tail == 0U) { // need to wrap the tail?
             tail = me->eQueue.end;
         }
@@ -285,6 +361,7 @@ static void QActive_postFIFO_(QActive * const me,
 
     if (me->eQueue.frontEvt.e == (QEvt *)0) { // is the queue empty?
         me->eQueue.frontEvt.e = e; // deliver event directly
+        QACTIVE_EQUEUE_STAMP_(me->eQueue.frontEvt);
 
 #ifdef QXK_H_
         if (me->super.state.act == Q_ACTION_CAST(0)) { // extended thread?
@@ -300,6 +377,7 @@ static void QActive_postFIFO_(QActive * const me,
     else { // queue was not empty, insert event into the ring-buffer
         QEQueueCtr head = me->eQueue.head; // get member into temporary
         me->eQueue.ring[head].e = e; // insert e into buffer
+        QACTIVE_EQUEUE_STAMP_(me->eQueue.ring[head]);
 
         if (head == 0U) { // need to wrap the head?
             head = me->eQueue.end;
@@ -310,6 +388,120 @@ static void QActive_postFIFO_(QActive * const me,
     }
 }
 
+#ifdef QF_EQUEUE_SPSC
+//............................................................................
+//! @private @memberof QActive
+static bool QActive_postSPSC_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender)
+{
+    // NOTE: this helper function is called *outside* critical section
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    bool wasEmpty;
+    bool const status = QEQueue_pushSPSC_(&me->eQueue, e, margin, &wasEmpty);
+
+    QF_CRIT_STAT
+    if (status) { // event posted?
+        if (wasEmpty) { // the consumer might be waiting for events?
+            QF_CRIT_ENTRY();
+
+            // the consumer might have already removed the posted event,
+            // so signal only if the queue is really not empty
+            if ((me->eQueue.frontEvt.e == (QEvt *)0)
+                && (!QEQueue_isEmpty(&me->eQueue)))
+            {
+                // deliver the next event to the front
+                me->eQueue.frontEvt.e = me->eQueue.ring[me->eQueue.tail].e;
+#ifdef QXK_H_
+                if (me->super.state.act == Q_ACTION_CAST(0)) { // xthread?
+                    QXTHREAD_EQUEUE_SIGNAL_(me); // signal eXtended Thread
+                }
+                else { // basic thread (AO)
+                    QACTIVE_EQUEUE_SIGNAL_(me); // signal the Active Object
+                }
+#else
+                QACTIVE_EQUEUE_SIGNAL_(me); // signal the Active Object
+#endif // def QXK_H_
+            }
+
+            QF_CRIT_EXIT();
+        }
+
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        QS_BEGIN_PRE(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE();        // timestamp
+            QS_OBJ_PRE(sender);   // the sender object
+            QS_SIG_PRE(e->sig);   // the signal of the event
+            QS_OBJ_PRE(me);       // this active object (recipient)
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_EQC_PRE(QEQueue_getFree(&me->eQueue)); // # free entries
+            QS_EQC_PRE(me->eQueue.nMin); // min # free entries
+        QS_END_PRE()
+        QS_CRIT_EXIT();
+    }
+    else { // event cannot be posted, but it is OK
+        QF_CRIT_ENTRY();
+
+        QS_BEGIN_PRE(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE();       // timestamp
+            QS_OBJ_PRE(sender);  // the sender object
+            QS_SIG_PRE(e->sig);  // the signal of the event
+            QS_OBJ_PRE(me);      // this active object (recipient)
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_EQC_PRE(QEQueue_getFree(&me->eQueue)); // # free entries
+            QS_EQC_PRE(margin);  // margin requested
+        QS_END_PRE()
+
+        QF_CRIT_EXIT();
+
+#if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); // recycle the event to avoid a leak
+#endif // (QF_MAX_EPOOL > 0U)
+    }
+
+#ifdef Q_UTEST
+    if (QS_LOC_CHECK_(me->prio)) {
+        QS_onTestPost(sender, me, e, status); // QUTEst callback
+    }
+#endif // def Q_USTEST
+
+    return status;
+}
+
+//............................................................................
+//! @public @memberof QActive
+void QActive_setSPSC(QActive * const me) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the AO's event queue must be still empty (no producers yet)
+    Q_REQUIRE_INCRIT(1000, me->eQueue.frontEvt.e == (QEvt *)0);
+
+    QEQueueCtr const qLen = me->eQueue.end; // ring buffer provided
+
+    // the SPSC ring buffer needs one empty slot to tell "full" from "empty"
+    Q_REQUIRE_INCRIT(1010, qLen >= 2U);
+
+    // NOTE: switch to the SPSC mode within the same crit.sect. as
+    // checking the empty queue (QEQueue_initSPSC() applies crit.sect.)
+    me->eQueue.head  = 0U;
+    me->eQueue.tail  = 0U;
+    me->eQueue.nFree = (QEQueueCtr)(qLen - 1U); // NOT updated in SPSC mode
+    me->eQueue.nMin  = me->eQueue.nFree;
+#ifdef QF_EQUEUE_SPSC_CHECK
+    me->eQueue.producer = 0U; // the producer not known yet
+#endif
+    me->eQueue.spsc  = 1U;
+
+    QF_CRIT_EXIT();
+}
+#endif // def QF_EQUEUE_SPSC
+
 //............................................................................
 //! @static @public @memberof QActive
 uint16_t QActive_getQueueUse(uint_fast8_t const prio) {
@@ -357,7 +549,8 @@ uint16_t QActive_getQueueFree(uint_fast8_t const prio) {
     Q_REQUIRE_INCRIT(610, a != (QActive *)0);
 
     // NOTE: critical section prevents asynchronous change of the free count
-    uint16_t const nFree = (uint16_t)a->eQueue.nFree;
+    // NOTE: QEQueue_getFree() does NOT apply crit.sect. internally
+    uint16_t const nFree = QEQueue_getFree(&a->eQueue);
 
     QF_CRIT_EXIT();
 
@@ -385,6 +578,64 @@ uint16_t QActive_getQueueMin(uint_fast8_t const prio) {
     return nMin;
 }
 
+#ifdef QACTIVE_LATENCY_BINS
+//............................................................................
+//! @static @public @memberof QActive
+uint32_t QActive_getLatency(uint_fast8_t const prio,
+    uint32_t * const hist,
+    bool const reset)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the queried prio. must be in range (excluding the idle thread)
+    Q_REQUIRE_INCRIT(1100, (0U < prio) && (prio <= QF_MAX_ACTIVE));
+
+    QActive * const a = QActive_registry_[prio];
+    // the AO must be registered (started)
+    Q_REQUIRE_INCRIT(1110, a != (QActive *)0);
+
+    // NOTE: critical section provides a consistent snapshot of the
+    // histogram, while the AO keeps running
+    uint32_t const latMax = a->latMax;
+    for (uint_fast8_t b = 0U; b < QACTIVE_LATENCY_BINS; ++b) {
+        if (hist != (uint32_t *)0) { // histogram requested?
+            hist[b] = a->latHist[b];
+        }
+        if (reset) {
+            a->latHist[b] = 0U;
+        }
+    }
+    if (reset) {
+        a->latMax = 0U;
+    }
+
+    QF_CRIT_EXIT();
+
+    return latMax;
+}
+
+//............................................................................
+//! @private @memberof QActive
+static void QActive_latency_(QActive * const me, uint32_t const ts) {
+    // NOTE: this helper function is called *inside* critical section
+
+    // enqueue-to-dispatch latency (modulo-2^32 timestamp difference)
+    uint32_t lat = QF_onGetTime() - ts;
+    if (me->latMax < lat) { // new maximum?
+        me->latMax = lat;
+    }
+
+    // log2-scale bin: 0 for lat==0, b for 2^(b-1) <= lat < 2^b,
+    // and the last bin collects all longer latencies
+    uint_fast8_t b = 0U;
+    for (; (lat != 0U) && (b < (QACTIVE_LATENCY_BINS - 1U)); lat >>= 1U) {
+        ++b;
+    }
+    ++me->latHist[b];
+}
+#endif // def QACTIVE_LATENCY_BINS
+
 //============================================================================
 #if (QF_MAX_TICK_RATE > 0U)
 
@@ -476,6 +727,7 @@ void QTicker_trig_(QTicker * const me, void const * const sender) {
         Q_REQUIRE_INCRIT(930, me->super.eQueue.frontEvt.e == (QEvt *)0);
 
         me->super.eQueue.frontEvt.e = &tickEvt; // deliver event directly
+        QACTIVE_EQUEUE_STAMP_(me->super.eQueue.frontEvt);
         me->super.eQueue.nFree = 0U;
 
         QACTIVE_EQUEUE_SIGNAL_(&me->super); // signal the event queue
@@ -39,6 +39,65 @@
 
 Q_DEFINE_THIS_MODULE("qf_defer")
 
+//! @static @private @memberof QEQueue
+static QEvt const * QEQueue_peekAt_(QEQueue const * const eq,
+    uint_fast16_t const i);
+
+//! @static @private @memberof QEQueue
+static QEQueueCtr QEQueue_ringIdx_(QEQueue const * const eq,
+    uint_fast16_t const i);
+
+//! @static @private @memberof QEQueue
+static void QEQueue_dropFront_(QEQueue * const eq,
+    uint_fast16_t const n);
+
+//! @static @private @memberof QEQueue
+static QEvt const * QEQueue_removeAt_(QEQueue * const eq,
+    uint_fast16_t const i);
+
+//! @static @private @memberof QActive
+static bool QActive_recallEvt_(QActive * const me,
+    struct QEQueue * const eq,
+    QEvt const * const e);
+
+//! @static @private @memberof QActive
+static bool QActive_isSig_(QEvt const * const e, void * const ctx);
+
+#ifdef QACTIVE_SNAPSHOT
+
+#if (QF_MAX_EPOOL == 0U)
+    #error QACTIVE_SNAPSHOT requires event pools (QF_MAX_EPOOL > 0)
+#endif
+#ifndef QF_EPOOL_FREE_
+    #error QACTIVE_SNAPSHOT requires QF_EPOOL_FREE_() in the port
+#endif
+
+// snapshot format version and the sizes of its fixed parts, see NOTE2
+#define QACTIVE_SNAP_VER_    1U
+#define QACTIVE_SNAP_HDR_    6U
+#define QACTIVE_SNAP_SUM_    2U
+#define QACTIVE_SNAP_EVT_    (sizeof(QSignal) + 2U)
+
+//! @static @private @memberof QActive
+static uint_fast16_t QActive_snapParSize_(QEvt const * const e);
+
+//! @static @private @memberof QActive
+static void QActive_snapPut_(uint8_t * const buf,
+    uint_fast16_t const pos,
+    uint32_t const val,
+    uint_fast8_t const n);
+
+//! @static @private @memberof QActive
+static uint32_t QActive_snapGet_(uint8_t const * const buf,
+    uint_fast16_t const pos,
+    uint_fast8_t const n);
+
+//! @static @private @memberof QActive
+static uint16_t QActive_snapSum_(uint8_t const * const buf,
+    uint_fast16_t const len);
+
+#endif // def QACTIVE_SNAPSHOT
+
 //............................................................................
 //! @protected @memberof QActive
 bool QActive_defer(QActive const * const me,
@@ -78,9 +137,513 @@ bool QActive_defer(QActive const * const me,
 bool QActive_recall(QActive * const me,
     struct QEQueue * const eq)
 {
+    return QActive_recallEvt_(me, eq, QEQueue_get(eq, me->prio));
+}
+
+//............................................................................
+//! @protected @memberof QActive
+uint16_t QActive_recallN(QActive * const me,
+    struct QEQueue * const eq,
+    uint_fast16_t const num)
+{
+    // NOTE: the deferred events are placed at the front of the AO's queue
+    // starting with the last one, so that they end up in the original
+    // FIFO order and ahead of the events already waiting in the AO's queue.
+
+#if (defined QACTIVE_EQUEUE_SIGNAL_) && (!defined Q_UTEST)
+    // the AO's event queue is the native QP event queue (QEQueue), so the
+    // deferred events can be moved in one critical section (see NOTE1)
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+#ifdef QF_EQUEUE_SPSC
+    // recalling is LIFO-posting, not allowed for the SPSC queues
+    Q_REQUIRE_INCRIT(300, (eq->spsc == 0U) && (me->eQueue.spsc == 0U));
+#endif
+
+    uint_fast16_t n = QEQueue_getUse(eq); // # deferred events
+    if (n > num) { // more deferred events than requested?
+        n = num;
+    }
+
+    QEQueueCtr nFree = me->eQueue.nFree; // get member into temporary
+
+    // the AO's queue must NOT overflow (as for QActive_recall())
+    Q_REQUIRE_INCRIT(310, nFree >= n);
+
+    if (n != 0U) { // any events to recall?
+        bool const wasEmpty = (me->eQueue.frontEvt.e == (QEvt *)0);
+
+        nFree -= (QEQueueCtr)n; // n free entries just used up
+        me->eQueue.nFree = nFree; // update the original
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; // update minimum so far
+        }
+
+        for (uint_fast16_t i = n; i > 0U; ) { // from the last one...
+            --i;
+            QEvt const * const e = QEQueue_peekAt_(eq, i);
+
+            // a mutable event must be referenced at least once by the
+            // deferred queue. This reference is transferred to the AO's
+            // queue, so the reference counter does NOT change.
+            Q_ASSERT_INCRIT(320, (e->poolNum_ == 0U) || (e->refCtr_ != 0U));
+
+            QEvtPtr const frontEvt = me->eQueue.frontEvt;
+            me->eQueue.frontEvt.e = e; // deliver the event to the front
+            QACTIVE_EQUEUE_STAMP_(me->eQueue.frontEvt);
+
+            if (frontEvt.e != (QEvt *)0) { // was the queue NOT empty?
+                QEQueueCtr tail = me->eQueue.tail; // get into temporary
+                ++tail;
+                if (tail == me->eQueue.end) { // need to wrap the tail?
+                    tail = 0U; // wrap around
+                }
+                me->eQueue.tail = tail;
+                me->eQueue.ring[tail] = frontEvt;
+            }
+
+            QS_BEGIN_PRE(QS_QF_ACTIVE_RECALL, me->prio)
+                QS_TIME_PRE();      // time stamp
+                QS_OBJ_PRE(me);     // this active object
+                QS_OBJ_PRE(eq);     // the deferred queue
+                QS_SIG_PRE(e->sig); // the signal of the event
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_END_PRE()
+        }
+
+        QEQueue_dropFront_(eq, n); // remove the recalled events
+
+        if (wasEmpty) { // was the AO's queue empty?
+            QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
+        }
+    }
+
+#else // the AO's event queue is provided by the underlying RTOS
+
+#ifdef QF_EQUEUE_SPSC
+    // the deferred queue must be a regular (not SPSC) queue
+    Q_REQUIRE_LOCAL(300, eq->spsc == 0U);
+#endif
+
+    // NOTE: the deferred queue is accessed only by this AO
+    uint_fast16_t n = QEQueue_getUse(eq); // # deferred events
+    if (n > num) { // more deferred events than requested?
+        n = num;
+    }
+
+    for (uint_fast16_t i = n; i > 0U; ) { // from the last one...
+        --i;
+
+        // post it to the front of the AO's queue.
+        // NOTE: asserts internally if the posting fails.
+        QACTIVE_POST_LIFO(me, QEQueue_peekAt_(eq, i));
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QEvt const * const e = QEQueue_peekAt_(eq, i);
+
+        if (e->poolNum_ != 0U) { // mutable event?
+            // the event must be referenced at least twice: once in
+            // the deferred event queue and once in the AO's event queue.
+            Q_ASSERT_INCRIT(330, e->refCtr_ >= 2U);
+
+            // decrement the reference counter once, to account for
+            // removing the event from the deferred queue.
+            QEvt_refCtr_dec_(e); // decrement the reference counter
+        }
+
+        QS_BEGIN_PRE(QS_QF_ACTIVE_RECALL, me->prio)
+            QS_TIME_PRE();      // time stamp
+            QS_OBJ_PRE(me);     // this active object
+            QS_OBJ_PRE(eq);     // the deferred queue
+            QS_SIG_PRE(e->sig); // the signal of the event
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+        QS_END_PRE()
+    }
+
+    QEQueue_dropFront_(eq, n); // remove the recalled events
+
+#endif // (defined QACTIVE_EQUEUE_SIGNAL_) && (!defined Q_UTEST)
+
+    if (n == 0U) { // nothing recalled?
+        QS_BEGIN_PRE(QS_QF_ACTIVE_RECALL_ATTEMPT, me->prio)
+            QS_TIME_PRE();      // time stamp
+            QS_OBJ_PRE(me);     // this active object
+            QS_OBJ_PRE(eq);     // the deferred queue
+        QS_END_PRE()
+    }
+
+    QF_CRIT_EXIT();
+
+    return (uint16_t)n;
+}
+
+//............................................................................
+//! @protected @memberof QActive
+bool QActive_recallIf(QActive * const me,
+    struct QEQueue * const eq,
+    QEvtPred const pred,
+    void * const ctx)
+{
+    Q_REQUIRE_LOCAL(400, pred != (QEvtPred)0);
+#ifdef QF_EQUEUE_SPSC
+    // the deferred queue must be a regular (not SPSC) queue
+    Q_REQUIRE_LOCAL(410, eq->spsc == 0U);
+#endif
+
+    // NOTE: the deferred queue is accessed only by this AO, so it can be
+    // searched outside critical section (the predicate is application code)
+    QEvt const *e = (QEvt *)0;
+    uint_fast16_t const nUse = QEQueue_getUse(eq);
+    for (uint_fast16_t i = 0U; i < nUse; ++i) {
+        QEvt const * const t = QEQueue_peekAt_(eq, i);
+        if ((*pred)(t, ctx)) { // the first matching event found?
+            // remove the event from the middle of the deferred queue
+            // without changing the order of the remaining events
+            e = QEQueue_removeAt_(eq, i);
+            break;
+        }
+    }
+
+    return QActive_recallEvt_(me, eq, e);
+}
+
+//............................................................................
+//! @protected @memberof QActive
+bool QActive_recallSig(QActive * const me,
+    struct QEQueue * const eq,
+    enum_t const sig)
+{
+    QSignal s = (QSignal)sig;
+    return QActive_recallIf(me, eq, &QActive_isSig_, &s);
+}
+
+//............................................................................
+//! @protected @memberof QActive
+uint16_t QActive_flushDeferred(QActive const * const me,
+    struct QEQueue * const eq,
+    uint_fast16_t const num)
+{
+    uint16_t n = 0U; // the flushed event counter
+    while (n < num) { // below the requested number?
+        QEvt const * const e = QEQueue_get(eq, me->prio);
+        if (e != (QEvt *)0) { // event obtained from the queue?
+            ++n; // count one more flushed event
+#if (QF_MAX_EPOOL > 0U)
+            QF_gc(e); // garbage collect
+#endif
+        }
+        else { // queue ran out of events
+            break; // done flushing
+        }
+    }
+
+    return n;
+}
+
+#ifdef QACTIVE_SNAPSHOT
+//............................................................................
+//! @protected @memberof QActive
+uint_fast16_t QActive_snapshot(QActive const * const me,
+    QSnapDesc const * const desc,
+    uint8_t * const buf,
+    uint_fast16_t const bufSize)
+{
+    Q_REQUIRE_LOCAL(700, (desc != (QSnapDesc *)0)
+                         && (buf != (uint8_t *)0));
+    Q_REQUIRE_LOCAL(710, (desc->blobSize == 0U)
+                         || (desc->blob != (void *)0));
+
+    // find the stable ID of the current state in the registry
+    uint_fast16_t id = 0U;
+    while ((id < desc->nStateIds)
+           && (desc->stateIds[id].uint != me->super.state.uint))
+    {
+        ++id;
+    }
+    // the current state must be registered
+    Q_ASSERT_LOCAL(720, id < desc->nStateIds);
+
+    // NOTE: the deferred queues are accessed only by this AO, so they
+    // are traversed without critical section (see QActive_recallIf())
+
+    // the size of the snapshot...
+    uint32_t size = (uint32_t)QACTIVE_SNAP_HDR_ + desc->blobSize
+                    + QACTIVE_SNAP_SUM_;
+    bool ok = true; // all deferred events can be saved?
+    for (uint_fast8_t q = 0U; q < desc->nDeferred; ++q) {
+        QEQueue const * const eq = desc->deferred[q];
+        uint_fast16_t const nUse = QEQueue_getUse(eq);
+        size += 2U; // the # deferred events
+        for (uint_fast16_t i = 0U; i < nUse; ++i) {
+            QEvt const * const e = QEQueue_peekAt_(eq, i);
+            // only the events from the QF event pools can be saved
+            // (not immutable events or events from other pools), see NOTE2
+            ok = ok && (e->poolNum_ != 0U)
+                    && (e->poolNum_ <= QF_priv_.maxPool_);
+            size += QACTIVE_SNAP_EVT_ + QActive_snapParSize_(e);
+        }
+    }
+
+    uint_fast16_t pos = 0U;
+    if (ok && (size <= bufSize)) { // the snapshot can be taken?
+        buf[0] = (uint8_t)QACTIVE_SNAP_VER_;
+        buf[1] = desc->nDeferred;
+        QActive_snapPut_(buf, 2U, (uint32_t)id, 2U);
+        QActive_snapPut_(buf, 4U, desc->blobSize, 2U);
+        pos = QACTIVE_SNAP_HDR_;
+
+        uint8_t const * const blob = (uint8_t const *)desc->blob;
+        for (uint_fast16_t i = 0U; i < desc->blobSize; ++i) {
+            buf[pos] = blob[i];
+            ++pos;
+        }
+
+        for (uint_fast8_t q = 0U; q < desc->nDeferred; ++q) {
+            QEQueue const * const eq = desc->deferred[q];
+            uint_fast16_t const nUse = QEQueue_getUse(eq);
+            QActive_snapPut_(buf, pos, nUse, 2U);
+            pos += 2U;
+            for (uint_fast16_t i = 0U; i < nUse; ++i) {
+                QEvt const * const e = QEQueue_peekAt_(eq, i);
+                uint_fast16_t const parSize = QActive_snapParSize_(e);
+                QActive_snapPut_(buf, pos, e->sig, sizeof(QSignal));
+                QActive_snapPut_(buf, pos + sizeof(QSignal), parSize, 2U);
+                pos += QACTIVE_SNAP_EVT_;
+
+                // the event parameters follow the QEvt base
+                uint8_t const * const par = (uint8_t const *)&e[1];
+                for (uint_fast16_t j = 0U; j < parSize; ++j) {
+                    buf[pos] = par[j];
+                    ++pos;
+                }
+            }
+        }
+
+        QActive_snapPut_(buf, pos, QActive_snapSum_(buf, pos), 2U);
+        pos += QACTIVE_SNAP_SUM_;
+    }
+
+    return pos; // 0 if the snapshot cannot be taken
+}
+
+//............................................................................
+//! @protected @memberof QActive
+QState QActive_restore(QActive * const me,
+    QSnapDesc const * const desc,
+    uint8_t const * const buf,
+    uint_fast16_t const len)
+{
+    Q_REQUIRE_LOCAL(800, (desc != (QSnapDesc *)0)
+                         && (buf != (uint8_t *)0));
+    Q_REQUIRE_LOCAL(810, (desc->blobSize == 0U)
+                         || (desc->blob != (void *)0));
+
+    // validate the whole snapshot before restoring anything...
+    bool ok = (len >= (QACTIVE_SNAP_HDR_ + QACTIVE_SNAP_SUM_));
+    uint_fast16_t end = 0U;      // the end of the snapshot data
+    uint_fast16_t id = 0U;       // the stable ID of the restored state
+    uint_fast16_t blobSize = 0U; // the size of the saved data blob
+    if (ok) {
+        end = len - QACTIVE_SNAP_SUM_;
+        id = (uint_fast16_t)QActive_snapGet_(buf, 2U, 2U);
+        blobSize = (uint_fast16_t)QActive_snapGet_(buf, 4U, 2U);
+        ok = (buf[0] == (uint8_t)QACTIVE_SNAP_VER_)
+             && (buf[1] == desc->nDeferred)
+             && (id < desc->nStateIds)
+             && (blobSize <= desc->blobSize) // the blob can only grow
+             && (QActive_snapGet_(buf, end, 2U)
+                 == QActive_snapSum_(buf, end));
+    }
+
+    // the # events to be allocated from every event pool
+    uint8_t const maxPool = QF_priv_.maxPool_;
+    uint16_t nNeed[QF_MAX_EPOOL];
+    for (uint_fast8_t k = 0U; k < QF_MAX_EPOOL; ++k) {
+        nNeed[k] = 0U;
+    }
+
+    uint_fast16_t pos = QACTIVE_SNAP_HDR_ + blobSize;
+    for (uint_fast8_t q = 0U; ok && (q < desc->nDeferred); ++q) {
+        ok = ((pos + 2U) <= end);
+        if (ok) {
+            uint_fast16_t const nEvt =
+                (uint_fast16_t)QActive_snapGet_(buf, pos, 2U);
+            pos += 2U;
+            // the deferred queue must be empty and accommodate all the
+            // events (so that a failed restore can flush it), see NOTE2
+            ok = QEQueue_isEmpty(desc->deferred[q])
+                 && (nEvt <= QEQueue_getFree(desc->deferred[q]));
+            for (uint_fast16_t i = 0U; ok && (i < nEvt); ++i) {
+                ok = ((pos + QACTIVE_SNAP_EVT_) <= end);
+                if (ok) {
+                    uint_fast16_t const parSize = (uint_fast16_t)
+                        QActive_snapGet_(buf, pos + sizeof(QSignal), 2U);
+                    pos += QACTIVE_SNAP_EVT_ + parSize;
+                    ok = (pos <= end);
+
+                    // find the event pool for the event (as QF_newX_())
+                    uint_fast8_t k = 0U;
+                    while ((k < maxPool)
+                           && ((sizeof(QEvt) + parSize)
+                               > QF_EPOOL_EVENT_SIZE_(QF_priv_.ePool_[k])))
+                    {
+                        ++k;
+                    }
+                    ok = ok && (k < maxPool); // the event must fit a pool
+                    if (ok) {
+                        ++nNeed[k];
+                    }
+                }
+            }
+        }
+    }
+    ok = ok && (pos == end);
+
+    // the event pools must have enough free blocks for all the events
+    for (uint_fast8_t k = 0U; ok && (k < maxPool); ++k) {
+        ok = (nNeed[k] <= QF_getPoolFree(k + 1U));
+    }
+
+    // re-create the deferred events first, because the allocation can
+    // still fail when the event pools are used concurrently, see NOTE2
+    pos = QACTIVE_SNAP_HDR_ + blobSize;
+    uint_fast8_t nQ = 0U; // # deferred queues with the re-created events
+    for (; ok && (nQ < desc->nDeferred); ++nQ) {
+        uint_fast16_t const nEvt =
+            (uint_fast16_t)QActive_snapGet_(buf, pos, 2U);
+        pos += 2U;
+        for (uint_fast16_t i = 0U; ok && (i < nEvt); ++i) {
+            QSignal const sig = (QSignal)
+                QActive_snapGet_(buf, pos, sizeof(QSignal));
+            uint_fast16_t const parSize = (uint_fast16_t)
+                QActive_snapGet_(buf, pos + sizeof(QSignal), 2U);
+            pos += QACTIVE_SNAP_EVT_;
+
+            // re-create the event as a mutable event (with margin, so
+            // that the allocation does not assert), see NOTE2
+            QEvt * const e = QF_newX_(sizeof(QEvt) + parSize,
+                                      0U, (enum_t)sig);
+            ok = (e != (QEvt *)0);
+            if (ok) {
+                uint8_t * const par = (uint8_t *)&e[1];
+                for (uint_fast16_t j = 0U; j < parSize; ++j) {
+                    par[j] = buf[pos];
+                    ++pos;
+                }
+
+                // cannot fail (the free entries were checked above)
+                (void)QActive_defer(me, desc->deferred[nQ], e);
+            }
+        }
+    }
+
+    QState r = Q_RET_UNHANDLED; // assume that the snapshot is invalid
+    if (ok) { // valid snapshot and all events re-created?
+        uint8_t * const blob = (uint8_t *)desc->blob;
+        pos = QACTIVE_SNAP_HDR_;
+        for (uint_fast16_t i = 0U; i < blobSize; ++i) { // see NOTE2
+            blob[i] = buf[pos];
+            ++pos;
+        }
+
+        // the restored state for the top-most initial tran.
+        me->super.temp = desc->stateIds[id];
+        r = Q_RET_RESTORE;
+    }
+    else { // release the events re-created so far (if any)
+        for (uint_fast8_t q = 0U; q < nQ; ++q) {
+            (void)QActive_flushDeferred(me, desc->deferred[q],
+                                        QEQueue_getUse(desc->deferred[q]));
+        }
+    }
+
+    return r;
+}
+#endif // def QACTIVE_SNAPSHOT
+
+//............................................................................
+//! @static @private @memberof QEQueue
+static QEvt const * QEQueue_peekAt_(QEQueue const * const eq,
+    uint_fast16_t const i)
+{
+    // NOTE: this function does NOT apply critical section and does NOT
+    // check that the queue holds more than 'i' events.
+    return (i == 0U)
+        ? eq->frontEvt.e // the i==0 event is at the front
+        : eq->ring[QEQueue_ringIdx_(eq, i)].e;
+}
+
+//............................................................................
+//! @static @private @memberof QEQueue
+static QEQueueCtr QEQueue_ringIdx_(QEQueue const * const eq,
+    uint_fast16_t const i)
+{
+    // the i-th event (i > 0) is in the ring buffer at the position 'i-1'
+    // from the tail, where the events are removed (counter-clockwise)
+    uint_fast16_t const tail = eq->tail;
+    uint_fast16_t const k = i - 1U;
+    return (QEQueueCtr)((tail >= k) ? (tail - k) : (tail + eq->end - k));
+}
+
+//............................................................................
+//! @static @private @memberof QEQueue
+static void QEQueue_dropFront_(QEQueue * const eq,
+    uint_fast16_t const n)
+{
+    // NOTE: this function does NOT apply critical section and does NOT
+    // touch the reference counters of the removed events.
+    if (n != 0U) { // anything to remove?
+        uint_fast16_t const nUse = QEQueue_getUse(eq);
+        uint_fast16_t m = n; // # events to take from the ring buffer
+        if (n < nUse) { // some events will remain in the queue?
+            eq->frontEvt.e = QEQueue_peekAt_(eq, n);
+        }
+        else { // the queue becomes empty
+            eq->frontEvt.e = (QEvt *)0;
+            --m; // the last removed event was at the front
+        }
+        uint_fast16_t const tail = eq->tail;
+        eq->tail = (QEQueueCtr)((tail >= m) ? (tail - m)
+                                            : (tail + eq->end - m));
+        eq->nFree = (QEQueueCtr)(eq->nFree + n);
+    }
+}
+
+//............................................................................
+//! @static @private @memberof QEQueue
+static QEvt const * QEQueue_removeAt_(QEQueue * const eq,
+    uint_fast16_t const i)
+{
+    // NOTE: this function does NOT apply critical section and does NOT
+    // touch the reference counter of the removed event.
+    QEvt const * const e = QEQueue_peekAt_(eq, i);
+
+    // move the events ahead of the removed one by one position back
+    for (uint_fast16_t j = i; j > 0U; --j) {
+        eq->ring[QEQueue_ringIdx_(eq, j)].e = QEQueue_peekAt_(eq, j - 1U);
+    }
+    QEQueue_dropFront_(eq, 1U); // the front event is now a duplicate
+
+    return e;
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+static bool QActive_recallEvt_(QActive * const me,
+    struct QEQueue * const eq,
+    QEvt const * const e)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(eq);
+#endif
+
     bool recalled = false; // assume failure
 
-    QEvt const * const e = QEQueue_get(eq, me->prio);
     if (e != (QEvt *)0) { // event available?
 
         // post it to the front of the AO's queue.
@@ -131,24 +694,100 @@ bool QActive_recall(QActive * const me,
 }
 
 //............................................................................
-//! @protected @memberof QActive
-uint16_t QActive_flushDeferred(QActive const * const me,
-    struct QEQueue * const eq,
-    uint_fast16_t const num)
+//! @static @private @memberof QActive
+static bool QActive_isSig_(QEvt const * const e, void * const ctx) {
+    return e->sig == *(QSignal const *)ctx;
+}
+
+#ifdef QACTIVE_SNAPSHOT
+//............................................................................
+//! @static @private @memberof QActive
+static uint_fast16_t QActive_snapParSize_(QEvt const * const e) {
+    // only the events from the QF event pools can be saved, see NOTE2
+    return ((e->poolNum_ == 0U) || (e->poolNum_ > QF_priv_.maxPool_))
+        ? 0U
+        : (uint_fast16_t)(QF_EPOOL_EVENT_SIZE_(
+              QF_priv_.ePool_[e->poolNum_ - 1U]) - sizeof(QEvt));
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+static void QActive_snapPut_(uint8_t * const buf,
+    uint_fast16_t const pos,
+    uint32_t const val,
+    uint_fast8_t const n)
 {
-    uint16_t n = 0U; // the flushed event counter
-    while (n < num) { // below the requested number?
-        QEvt const * const e = QEQueue_get(eq, me->prio);
-        if (e != (QEvt *)0) { // event obtained from the queue?
-            ++n; // count one more flushed event
-#if (QF_MAX_EPOOL > 0U)
-            QF_gc(e); // garbage collect
-#endif
-        }
-        else { // queue ran out of events
-            break; // done flushing
-        }
+    for (uint_fast8_t i = 0U; i < n; ++i) { // little endian
+        buf[pos + i] = (uint8_t)(val >> (8U * i));
     }
+}
 
-    return n;
+//............................................................................
+//! @static @private @memberof QActive
+static uint32_t QActive_snapGet_(uint8_t const * const buf,
+    uint_fast16_t const pos,
+    uint_fast8_t const n)
+{
+    uint32_t val = 0U;
+    for (uint_fast8_t i = n; i > 0U; --i) { // little endian
+        val = (val << 8U) | buf[pos + i - 1U];
+    }
+    return val;
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+static uint16_t QActive_snapSum_(uint8_t const * const buf,
+    uint_fast16_t const len)
+{
+    // Fletcher-16 checksum
+    uint_fast16_t s1 = 0U;
+    uint_fast16_t s2 = 0U;
+    for (uint_fast16_t i = 0U; i < len; ++i) {
+        s1 = (s1 + buf[i]) % 255U;
+        s2 = (s2 + s1) % 255U;
+    }
+    return (uint16_t)((s2 << 8U) | s1);
 }
+#endif // def QACTIVE_SNAPSHOT
+
+//============================================================================
+// NOTE1:
+// QActive_recallN() with the native QP event queue moves the deferred events
+// directly between the two queues. The events are removed from the deferred
+// queue and inserted into the AO's queue at the same time, so the reference
+// counters of the mutable events remain unchanged. In contrast, the generic
+// implementation for the RTOS queues posts the events with
+// QACTIVE_POST_LIFO() (which increments the reference counters) and then
+// decrements the reference counters when removing the events from the
+// deferred queue, as QActive_recall() does.
+//
+// NOTE2:
+// The snapshot of an AO (QActive_snapshot()) is a byte buffer in the
+// little-endian format, which does not depend on the addresses of the
+// states and events, so it remains valid across a restart and even an
+// upgrade of the application (as long as the registry of the stable state
+// IDs is only extended and the data blob only grows at its end):
+// - version (1 byte), # deferred queues (1 byte)
+// - stable ID of the current state (2 bytes), blob size (2 bytes)
+// - the application data blob
+// - for every deferred queue: # events (2 bytes) and for every event:
+//   signal (sizeof(QSignal) bytes), parameter size (2 bytes), parameters
+// - Fletcher-16 checksum of all the preceding bytes (2 bytes)
+// The parameter size of a mutable event is the block size of its event
+// pool (the actual size of the event is not recorded in the event). The
+// size of an immutable event or of an event from another pool (e.g., a
+// shared-memory channel with QF_SHM) is not known, so QActive_snapshot()
+// returns 0 (no snapshot) when any such event is deferred. The deferred
+// events are restored as mutable events allocated from the event pools.
+// A saved blob shorter than the current one is restored into the
+// beginning of the blob, and the rest keeps the values set before
+// QActive_restore() (e.g., in the AO constructor).
+// QActive_restore() validates the whole snapshot before restoring anything,
+// including the empty deferred queues, the event pools that fit the events
+// and their free blocks. The events are then allocated with a margin,
+// because other AOs or ISRs can still allocate from the same pools
+// meanwhile. When an allocation fails, the events re-created so far are
+// flushed from the deferred queues, so an invalid snapshot or a failed
+// restore leaves the AO intact and the initial tran. can proceed normally.
+// The data blob and the state are restored only after all events.
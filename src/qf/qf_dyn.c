@@ -287,6 +287,16 @@ void QF_gc(QEvt const * const e) {
 
             QF_CRIT_EXIT();
         }
+#ifdef QF_EPOOL_EXT_PUT_
+        else if (poolNum > QF_MAX_EPOOL) { // event from an external pool?
+            QF_CRIT_EXIT();
+
+            // call port-specific operation to put the event to the external
+            // (e.g., shared-memory) event pool
+            // NOTE: casting 'const' away is legit because 'e' is a pool event
+            QF_EPOOL_EXT_PUT_((QEvt *)e);
+        }
+#endif // def QF_EPOOL_EXT_PUT_
         else { // this is the last reference to this event, recycle it
 #ifndef Q_UNSAFE
             uint8_t const maxPool = QF_priv_.maxPool_;
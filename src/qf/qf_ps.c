@@ -41,14 +41,83 @@ Q_DEFINE_THIS_MODULE("qf_ps")
 
 QSubscrList * QActive_subscrList_;
 QSignal QActive_maxPubSignal_;
+#ifdef QF_PS_SPARSE
+uint16_t QActive_subscrMask_;
+#endif
+#ifdef QF_MAX_SUBSCR_RANGE
+QSubscrRange QActive_subscrRange_[QF_MAX_SUBSCR_RANGE];
+uint8_t QActive_nSubscrRange_;
+QSubscrRange QActive_rangeSpan_;
+#endif
+
+// static local helper functions (declarations)
+static void QActive_subscribe_(QActive const * const me,
+    enum_t const sig,
+    QEvtPred const filter,
+    void * const ctx);
+
+static void QActive_publishEvt_(QEvt const * const e,
+    void const * const sender,
+    uint_fast8_t const qsId,
+    uint_fast8_t const ceiling);
+
+static uint_fast8_t QActive_batchCeiling_(
+    QEvt const * const evts[],
+    uint_fast8_t const n);
+
+#ifdef QF_MAX_SUBSCR
+static uint_fast8_t QActive_multicast_(
+    QSubscr subscr[],
+    uint_fast8_t const nSubscr,
+    QEvt const * const e,
+    void const * const sender,
+    uint_fast8_t const ceiling);
+
+static void QSubscrList_insert_(QSubscrList * const me,
+    QActive * const a,
+    QEvtPred const filter,
+    void * const ctx);
+
+static void QSubscrList_remove_(QSubscrList * const me,
+    uint_fast8_t const p);
+
+static QSubscr * QSubscrList_find_(QSubscrList * const me,
+    QActive const * const a);
 
+static void QActive_subscrDrop_(QActive const * const me,
+    QSignal const sig);
 
-// static local helper function (declaration)
-static void QActive_multicast_(
+static bool QActive_conflate_(QActive * const me,
+    QEvt const * const e);
+
+#if (QF_MAX_EPOOL > 0U)
+static void QActive_holdEvt_(QEvt const * const e);
+#endif
+#else
+static uint_fast8_t QActive_multicast_(
     QPSet * const subscrSet,
     QEvt const * const e,
-    void const * const sender);
+    void const * const sender,
+    uint_fast8_t const ceiling);
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_STATS
+static void QPubStats_reset_(QPubStats * const me);
+#endif
+
+#ifdef QF_MAX_SUBSCR_RANGE
+static void QActive_rangeRemove_(uint_fast8_t const i);
+#endif // def QF_MAX_SUBSCR_RANGE
 
+#ifdef QACTIVE_SUBSCR_INDEX
+static void QActive_indexAdd_(QActive * const me,
+    QSignal const sig);
+
+static void QActive_indexRemove_(QActive * const me,
+    QSignal const sig);
+#endif // def QACTIVE_SUBSCR_INDEX
+
+#ifndef QF_PS_SPARSE
 //............................................................................
 //! @static @public @memberof QActive
 void QActive_psInit(
@@ -68,19 +137,213 @@ void QActive_psInit(
 
     QActive_subscrList_   = subscrSto;
     QActive_maxPubSignal_ = (QSignal)maxSignal;
+#ifdef QF_MAX_SUBSCR_RANGE
+    QActive_nSubscrRange_ = 0U; // no range subscriptions
+#endif
 
     // initialize all signals in the subscriber list...
     for (enum_t sig = 0; sig < maxSignal; ++sig) {
         QPSet_setEmpty(&subscrSto[sig].set); // no subscibers to this signal
+#ifdef QF_MAX_SUBSCR
+        subscrSto[sig].nSubscr = 0U;
+#endif
+#ifdef QF_PS_RETAIN
+        subscrSto[sig].retained = (QEvt *)0;
+        subscrSto[sig].retain   = false;
+#endif
+#ifdef QF_PS_STATS
+        QPubStats_reset_(&subscrSto[sig].stats);
+#endif
+    }
+}
+
+#else // QF_PS_SPARSE defined
+
+//............................................................................
+//! @static @public @memberof QActive
+void QActive_psInitSparse(
+    QSubscrList * const subscrSto,
+    uint_fast16_t const nSlots,
+    enum_t const maxSignal)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // provided subscSto must be valid
+    Q_REQUIRE_INCRIT(150, subscrSto != (QSubscrList *)0);
+
+    // the number of slots must be a power of 2 within the 16-bit range
+    Q_REQUIRE_INCRIT(160, (0U < nSlots) && (nSlots <= 0x10000U)
+        && ((nSlots & (nSlots - 1U)) == 0U));
+
+    // provided maximum of subscribed signals must be >= Q_USER_SIG
+    Q_REQUIRE_INCRIT(170, maxSignal >= Q_USER_SIG);
+
+    QF_CRIT_EXIT();
+
+    QActive_subscrList_   = subscrSto;
+    QActive_subscrMask_   = (uint16_t)(nSlots - 1U);
+    QActive_maxPubSignal_ = (QSignal)maxSignal;
+#ifdef QF_MAX_SUBSCR_RANGE
+    QActive_nSubscrRange_ = 0U; // no range subscriptions
+#endif
+
+    // initialize all slots in the sparse subscriber table...
+    for (uint_fast16_t i = 0U; i < nSlots; ++i) {
+        subscrSto[i].sig = 0U; // the slot is free
+        QPSet_setEmpty(&subscrSto[i].set); // no subscibers in this slot
+#ifdef QF_MAX_SUBSCR
+        subscrSto[i].nSubscr = 0U;
+#endif
+#ifdef QF_PS_RETAIN
+        subscrSto[i].retained = (QEvt *)0;
+        subscrSto[i].retain   = false;
+#endif
+#ifdef QF_PS_STATS
+        QPubStats_reset_(&subscrSto[i].stats);
+#endif
     }
 }
 
+//............................................................................
+//! @static @private @memberof QActive
+QSubscrList * QActive_subscrFind_(
+    QSignal const sig,
+    bool const create)
+{
+    // NOTE: must be called inside a critical section, see NOTE2
+    uint_fast16_t const mask = QActive_subscrMask_;
+    uint_fast16_t i = (uint_fast16_t)sig & mask;
+    QSubscrList *sl = (QSubscrList *)0;
+
+    // NOTE: the linear probing is bounded by the number of slots
+    for (uint_fast16_t n = mask + 1U; n > 0U; --n) {
+        QSubscrList * const slot = &QActive_subscrList_[i];
+        if (slot->sig == sig) { // signal found?
+            sl = slot;
+            break;
+        }
+        if (slot->sig == 0U) { // free slot (end of the probe sequence)?
+            if (create) { // claim the free slot for the signal
+                slot->sig = sig;
+                sl = slot;
+            }
+            break;
+        }
+        i = (i + 1U) & mask; // next slot (with wrap-around)
+    }
+
+    // a new signal must find a free slot in the sparse subscriber table
+    Q_ENSURE_INCRIT(190, (!create) || (sl != (QSubscrList *)0));
+
+    return sl;
+}
+
+#endif // ndef QF_PS_SPARSE
+
 //............................................................................
 //! @static @private @memberof QActive
 void QActive_publish_(
     QEvt const * const e,
     void const * const sender,
     uint_fast8_t const qsId)
+{
+    QActive_publishEvt_(e, sender, qsId, 0U); // scheduler not locked yet
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+void QActive_publishN_(
+    QEvt const * const evts[],
+    uint_fast8_t const n,
+    void const * const sender,
+    uint_fast8_t const qsId)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the array of published events must be valid
+    Q_REQUIRE_INCRIT(1500, evts != (QEvt const **)0);
+
+    // the highest-prio subscriber in the union of all subscriber sets
+    uint_fast8_t ceiling = QActive_batchCeiling_(evts, n);
+
+    QF_CRIT_EXIT();
+
+    // lock the scheduler up to the ceiling and re-check the ceiling with
+    // the scheduler locked, until it covers all subscribers, see NOTE7
+    QF_SCHED_STAT_
+    uint_fast8_t locked = 0U; // the prio. ceiling of the scheduler lock
+    // NOTE: the loop is bounded by QF_MAX_ACTIVE, because the ceiling
+    // can only grow (by at least one) in every pass
+    for (uint_fast8_t k = QF_MAX_ACTIVE; (ceiling > locked) && (k > 0U); --k)
+    {
+        if (locked != 0U) { // locked already (with a lower ceiling)?
+            QF_SCHED_UNLOCK_();
+        }
+        QF_SCHED_LOCK_(ceiling);
+        locked = ceiling;
+
+        QF_CRIT_ENTRY();
+        ceiling = QActive_batchCeiling_(evts, n);
+        QF_CRIT_EXIT();
+    }
+
+    // publish the events in order, so every subscriber receives its
+    // events in the same order as they appear in the batch
+    // (an event without subscribers still needs to be processed)
+    for (uint_fast8_t i = 0U; i < n; ++i) {
+        QActive_publishEvt_(evts[i], sender, qsId, locked);
+    }
+
+    if (locked != 0U) { // was the scheduler locked?
+        QF_SCHED_UNLOCK_(); // unlock the scheduler
+    }
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+static uint_fast8_t QActive_batchCeiling_(
+    QEvt const * const evts[],
+    uint_fast8_t const n)
+{
+    // NOTE: must be called inside a critical section
+    uint_fast8_t ceiling = 0U;
+    for (uint_fast8_t i = 0U; i < n; ++i) {
+        QEvt const * const e = evts[i];
+
+        // each published event must be valid and its signal in range
+        Q_REQUIRE_INCRIT(1510, (e != (QEvt *)0)
+            && ((QSignal)e->sig < QActive_maxPubSignal_));
+
+        QSubscrList const * const sl =
+            QActive_subscrFind_((QSignal)e->sig, false);
+        QPSet subscrSet;
+        if (sl != (QSubscrList *)0) {
+            subscrSet = sl->set;
+        }
+        else {
+            QPSet_setEmpty(&subscrSet);
+        }
+#ifdef QF_MAX_SUBSCR_RANGE
+        (void)QActive_rangeSubscr_((QSignal)e->sig, &subscrSet);
+#endif
+        if (QPSet_notEmpty(&subscrSet)) {
+            uint_fast8_t const p = QPSet_findMax(&subscrSet);
+            if (p > ceiling) {
+                ceiling = p;
+            }
+        }
+    }
+    return ceiling;
+}
+
+//............................................................................
+//! @private @memberof QActive
+static void QActive_publishEvt_(QEvt const * const e,
+    void const * const sender,
+    uint_fast8_t const qsId,
+    uint_fast8_t const ceiling)
 {
 #ifndef Q_SPY
     Q_UNUSED_PAR(sender);
@@ -98,8 +361,41 @@ void QActive_publish_(
     // published event signal must not exceed the maximum
     Q_REQUIRE_INCRIT(240, sig < QActive_maxPubSignal_);
 
+    // subscriber list of the signal (might be NULL for sparse storage)
+    QSubscrList * const sl = QActive_subscrFind_(sig, false);
+
+#ifdef QF_MAX_SUBSCR
+    // make a local copy of the precomputed subscriber array, see NOTE1
+    uint_fast8_t nSubscr = (sl != (QSubscrList *)0) ? sl->nSubscr : 0U;
+#ifdef QF_MAX_SUBSCR_RANGE
+    QSubscr subscr[QF_MAX_SUBSCR + QF_MAX_SUBSCR_RANGE];
+#else
+    QSubscr subscr[QF_MAX_SUBSCR];
+#endif
+    for (uint_fast8_t i = 0U; i < nSubscr; ++i) {
+        subscr[i] = sl->subscr[i];
+    }
+#ifdef QF_MAX_SUBSCR_RANGE
+    QPSet rangeSet;
+    QPSet_setEmpty(&rangeSet);
+    if (QActive_rangeSubscr_(sig, &rangeSet)) { // any range subscribers?
+        nSubscr = QActive_rangeMerge_(subscr, nSubscr, &rangeSet);
+    }
+#endif
+#else
     // make a local, modifiable copy of the subscriber set
-    QPSet subscrSet = QActive_subscrList_[sig].set;
+    QPSet subscrSet;
+    if (sl != (QSubscrList *)0) {
+        subscrSet = sl->set;
+    }
+    else {
+        QPSet_setEmpty(&subscrSet);
+    }
+#ifdef QF_MAX_SUBSCR_RANGE
+    // add the range subscribers (if any) to the subscriber set, see NOTE8
+    (void)QActive_rangeSubscr_(sig, &subscrSet);
+#endif
+#endif // def QF_MAX_SUBSCR
 
     QS_BEGIN_PRE(QS_QF_PUBLISH, qsId)
         QS_TIME_PRE();          // the timestamp
@@ -118,11 +414,62 @@ void QActive_publish_(
         QEvt_refCtr_inc_(e);
     }
 
+#ifdef QF_PS_STATS
+    if (sl != (QSubscrList *)0) { // not a slot-less sparse signal? NOTE6
+        ++sl->stats.nPub; // count the publish
+    }
+#endif
+
+#ifdef QF_PS_RETAIN
+    QEvt const *old = (QEvt *)0; // previously retained event
+    if ((sl != (QSubscrList *)0) && sl->retain) { // retained signal?
+        if (e->poolNum_ != 0U) { // is it a mutable event?
+            QEvt_refCtr_inc_(e); // referenced by the retained cache now
+        }
+        old = sl->retained;
+        sl->retained = e; // replace the retained event, see NOTE5
+    }
+#endif // def QF_PS_RETAIN
+
     QF_CRIT_EXIT();
 
+#ifdef QF_PS_RETAIN
+#if (QF_MAX_EPOOL > 0U)
+    if (old != (QEvt *)0) { // was an event retained before?
+        QF_gc(old); // release the previously retained event
+    }
+#endif
+#endif // def QF_PS_RETAIN
+
+#ifdef QF_PS_STATS
+    uint32_t const start = QF_onGetTime(); // start of the fan-out
+#endif
+
+    uint_fast8_t nDeliv = 0U; // # events delivered to the subscribers
+#ifdef QF_MAX_SUBSCR
+    if (nSubscr != 0U) { // any subscribers?
+        // multicast to all
+        nDeliv = QActive_multicast_(subscr, nSubscr, e, sender, ceiling);
+    }
+#else
     if (QPSet_notEmpty(&subscrSet)) { // any subscribers?
-        QActive_multicast_(&subscrSet, e, sender); // multicast to all
+        // multicast to all
+        nDeliv = QActive_multicast_(&subscrSet, e, sender, ceiling);
     }
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_STATS
+    if (sl != (QSubscrList *)0) {
+        uint32_t const time = QF_onGetTime() - start;
+
+        QF_CRIT_ENTRY();
+        sl->stats.nDeliv += nDeliv;
+        sl->stats.time   += time; // cumulative fan-out time
+        QF_CRIT_EXIT();
+    }
+#else
+    Q_UNUSED_PAR(nDeliv);
+#endif // def QF_PS_STATS
 
     // The following garbage collection step decrements the reference counter
     // and recycles the event if the counter drops to zero. This covers both
@@ -132,12 +479,430 @@ void QActive_publish_(
 #endif
 }
 
+#ifdef QF_MAX_SUBSCR
 //............................................................................
 //! @private @memberof QActive
-static void QActive_multicast_(
+static uint_fast8_t QActive_multicast_(
+    QSubscr subscr[],
+    uint_fast8_t const nSubscr,
+    QEvt const * const e,
+    void const * const sender,
+    uint_fast8_t const ceiling)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    uint_fast8_t nDeliv = 0U; // # delivered events
+
+    // drop the subscribers whose filters reject the event, see NOTE3
+    uint_fast8_t n = 0U;
+    for (uint_fast8_t i = 0U; i < nSubscr; ++i) {
+        QEvtPred const filter = subscr[i].filter;
+        if ((filter == (QEvtPred)0) || (*filter)(e, subscr[i].ctx)) {
+            subscr[n] = subscr[i]; // keep the accepting subscriber
+            ++n;
+        }
+    }
+
+    if (n != 0U) { // any accepting subscribers?
+        // lock the scheduler up to max prio (unless already locked there)
+        uint_fast8_t const p = subscr[0].ao->prio;
+        bool const lock = (p > ceiling);
+        QF_SCHED_STAT_
+        if (lock) {
+            QF_SCHED_LOCK_(p);
+        }
+
+#if (QF_MAX_EPOOL > 0U)
+        bool held = false; // extra reference held for failed posts? NOTE4
+#endif
+
+        // NOTE: the subscribers are sorted by descending priority and have
+        // been validated already when they subscribed, so no further lookups
+        // are needed. The loop is bounded by QF_MAX_SUBSCR.
+        for (uint_fast8_t i = 0U; i < n; ++i) {
+            QSubscr const * const s = &subscr[i];
+            if (s->policy == (uint8_t)Q_SUBSCR_ASSERT) { // default policy?
+                // QACTIVE_POST() asserts internally if the queue overflows
+                QACTIVE_POST(s->ao, e, sender);
+                ++nDeliv;
+            }
+            else { // best-effort subscriber
+#if (QF_MAX_EPOOL > 0U)
+                if (!held) {
+                    QActive_holdEvt_(e);
+                    held = true;
+                }
+#endif
+                if (QACTIVE_POST_X(s->ao, e, s->margin, sender)) {
+                    ++nDeliv;
+                }
+                else {
+#if (QF_MAX_EPOOL > 0U)
+                    held = false; // the failed post released the extra ref.
+#endif
+                    if ((s->policy == (uint8_t)Q_SUBSCR_CONFLATE)
+                        && QActive_conflate_(s->ao, e))
+                    {
+                        ++nDeliv; // delivered by replacing a queued event
+                    }
+                    else {
+                        QActive_subscrDrop_(s->ao, (QSignal)e->sig);
+                    }
+                }
+            }
+        }
+
+#if (QF_MAX_EPOOL > 0U)
+        if (held) { // still holding the extra reference?
+            QF_gc(e); // release it (the publisher still holds the event)
+        }
+#endif
+
+        if (lock) {
+            QF_SCHED_UNLOCK_(); // unlock the scheduler
+        }
+    }
+
+    return nDeliv;
+}
+
+//............................................................................
+//! @private @memberof QSubscrList
+static void QSubscrList_insert_(QSubscrList * const me,
+    QActive * const a,
+    QEvtPred const filter,
+    void * const ctx)
+{
+    // NOTE: must be called inside a critical section
+    uint_fast8_t const p = a->prio;
+    uint_fast8_t i = me->nSubscr;
+    if (QPSet_hasElement(&me->set, p)) { // subscribed already?
+        for (i = 0U; me->subscr[i].ao != a; ++i) { // find the subscriber
+            // the subscriber must be in the array
+            Q_ASSERT_INCRIT(705, i < ((uint_fast8_t)me->nSubscr - 1U));
+        }
+    }
+    else { // new subscriber
+
+        // the number of subscribers to a signal must not exceed the maximum
+        Q_ASSERT_INCRIT(710, i < QF_MAX_SUBSCR);
+
+        // shift all lower-prio subscribers to make room for the new one
+        for (; (i > 0U) && (me->subscr[i - 1U].ao->prio < p); --i) {
+            me->subscr[i] = me->subscr[i - 1U];
+        }
+        me->subscr[i].ao     = a;
+        me->subscr[i].policy = (uint8_t)Q_SUBSCR_ASSERT;
+        me->subscr[i].margin = 0U;
+        me->subscr[i].nDrop  = 0U;
+        ++me->nSubscr;
+    }
+    me->subscr[i].filter = filter; // (re)set the filter
+    me->subscr[i].ctx    = ctx;
+}
+
+//............................................................................
+//! @private @memberof QSubscrList
+static void QSubscrList_remove_(QSubscrList * const me,
+    uint_fast8_t const p)
+{
+    // NOTE: must be called inside a critical section
+    if (QPSet_hasElement(&me->set, p)) { // subscribed?
+        uint_fast8_t const n = (uint_fast8_t)me->nSubscr - 1U;
+        uint_fast8_t i = 0U;
+        for (; me->subscr[i].ao->prio != p; ++i) { // find the subscriber
+            // the subscriber must be in the array
+            Q_ASSERT_INCRIT(810, i < n);
+        }
+        for (; i < n; ++i) { // close the gap
+            me->subscr[i] = me->subscr[i + 1U];
+        }
+        me->nSubscr = (uint8_t)n;
+    }
+}
+
+//............................................................................
+//! @private @memberof QSubscrList
+static QSubscr * QSubscrList_find_(QSubscrList * const me,
+    QActive const * const a)
+{
+    // NOTE: must be called inside a critical section
+    QSubscr *s = (QSubscr *)0;
+    uint_fast8_t const n = me->nSubscr;
+    for (uint_fast8_t i = 0U; i < n; ++i) {
+        if (me->subscr[i].ao == a) {
+            s = &me->subscr[i];
+            break;
+        }
+    }
+    return s;
+}
+
+//............................................................................
+//! @private @memberof QActive
+static void QActive_subscrDrop_(QActive const * const me,
+    QSignal const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    QSubscrList * const sl = QActive_subscrFind_(sig, false);
+    if (sl != (QSubscrList *)0) {
+        QSubscr * const s = QSubscrList_find_(sl, me);
+        if (s != (QSubscr *)0) { // still subscribed?
+            ++s->nDrop; // count the dropped event
+        }
+#ifdef QF_PS_STATS
+        ++sl->stats.nDrop; // count the dropped event for the signal
+#endif
+    }
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @private @memberof QActive
+static bool QActive_conflate_(QActive * const me,
+    QEvt const * const e)
+{
+    bool conflated = false;
+
+#if (defined QACTIVE_EQUEUE_SIGNAL_) && (!defined Q_UTEST)
+    QEvt const *old = (QEvt *)0;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    QEQueue * const eq = &me->eQueue;
+#ifdef QF_EQUEUE_SPSC
+    if (eq->spsc == 0U) // SPSC queues cannot be modified by the producer
+#endif
+    {
+        // # events in the queue (the front event + events in the ring)
+        uint_fast16_t i = (eq->frontEvt.e != (QEvt *)0)
+            ? ((uint_fast16_t)eq->end + 1U - (uint_fast16_t)eq->nFree)
+            : 0U;
+
+        // replace the most recently queued event with the same signal
+        // NOTE: the loop is bounded by the queue length
+        while (i > 0U) {
+            --i;
+            QEvtPtr *ptr = &eq->frontEvt; // the i==0 event is at the front
+            if (i > 0U) { // the i-th event is 'i-1' from the tail
+                uint_fast16_t const tail = eq->tail;
+                uint_fast16_t const k = i - 1U;
+                ptr = &eq->ring[(tail >= k) ? (tail - k)
+                                            : (tail + eq->end - k)];
+            }
+            if (ptr->e->sig == e->sig) { // same signal?
+#if (QF_MAX_EPOOL > 0U)
+                if (e->poolNum_ != 0U) { // is it a mutable event?
+                    QEvt_refCtr_inc_(e); // referenced by the queue now
+                }
+#endif
+                old = ptr->e;
+                ptr->e = e; // replace the event (keep the timestamp)
+                conflated = true;
+                break;
+            }
+        }
+    }
+
+    QF_CRIT_EXIT();
+
+#if (QF_MAX_EPOOL > 0U)
+    if (old != (QEvt *)0) { // event replaced?
+        QF_gc(old); // release the replaced event
+    }
+#endif
+
+#else // conflating needs the native QP event queue (QEQueue)
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(e);
+#endif
+
+    return conflated;
+}
+
+#if (QF_MAX_EPOOL > 0U)
+//............................................................................
+//! @private @memberof QActive
+static void QActive_holdEvt_(QEvt const * const e) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    if (e->poolNum_ != 0U) { // is it a mutable event?
+        QEvt_refCtr_inc_(e);
+    }
+
+    QF_CRIT_EXIT();
+}
+#endif // (QF_MAX_EPOOL > 0U)
+
+//............................................................................
+//! @protected @memberof QActive
+void QActive_setSubscrPolicy(QActive const * const me,
+    enum_t const sig,
+    enum QSubscrPolicy const policy,
+    uint_fast16_t const margin)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the policy must be one of the defined ones
+    Q_REQUIRE_INCRIT(1100, (policy == Q_SUBSCR_ASSERT)
+        || (policy == Q_SUBSCR_DROP) || (policy == Q_SUBSCR_CONFLATE));
+
+    // the signal must be in range
+    Q_REQUIRE_INCRIT(1110, (sig >= Q_USER_SIG)
+        && ((QSignal)sig < QActive_maxPubSignal_));
+
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, false);
+    QSubscr * const s = (sl != (QSubscrList *)0)
+        ? QSubscrList_find_(sl, me)
+        : (QSubscr *)0;
+
+    // the AO must be subscribed to the signal
+    Q_REQUIRE_INCRIT(1120, s != (QSubscr *)0);
+
+    s->policy = (uint8_t)policy;
+    s->margin = (uint16_t)margin;
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @protected @memberof QActive
+uint32_t QActive_getSubscrDrops(QActive const * const me,
+    enum_t const sig,
+    bool const reset)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the signal must be in range
+    Q_REQUIRE_INCRIT(1210, (sig >= Q_USER_SIG)
+        && ((QSignal)sig < QActive_maxPubSignal_));
+
+    uint32_t nDrop = 0U;
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, false);
+    QSubscr * const s = (sl != (QSubscrList *)0)
+        ? QSubscrList_find_(sl, me)
+        : (QSubscr *)0;
+    if (s != (QSubscr *)0) { // subscribed?
+        nDrop = s->nDrop;
+        if (reset) {
+            s->nDrop = 0U;
+        }
+    }
+
+    QF_CRIT_EXIT();
+
+    return nDrop;
+}
+
+#endif // def QF_MAX_SUBSCR
+
+#ifdef QF_PS_RETAIN
+//............................................................................
+//! @static @public @memberof QActive
+void QActive_setRetain(
+    enum_t const sig,
+    bool const enable)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the signal must be in range
+    Q_REQUIRE_INCRIT(1310, (sig >= Q_USER_SIG)
+        && ((QSignal)sig < QActive_maxPubSignal_));
+
+    QEvt const *old = (QEvt *)0;
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, enable);
+    if (sl != (QSubscrList *)0) {
+        sl->retain = enable;
+        if (!enable) { // no longer retained?
+            old = sl->retained;
+            sl->retained = (QEvt *)0;
+        }
+    }
+
+    QF_CRIT_EXIT();
+
+#if (QF_MAX_EPOOL > 0U)
+    if (old != (QEvt *)0) { // was an event retained?
+        QF_gc(old); // release the retained event
+    }
+#endif
+}
+#endif // def QF_PS_RETAIN
+
+#ifdef QF_PS_STATS
+//............................................................................
+//! @static @public @memberof QActive
+void QActive_getPubStats(
+    enum_t const sig,
+    QPubStats * const stats,
+    bool const reset)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the signal must be in range and the stats must be provided
+    Q_REQUIRE_INCRIT(1410, (sig >= Q_USER_SIG)
+        && ((QSignal)sig < QActive_maxPubSignal_)
+        && (stats != (QPubStats *)0));
+
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, false);
+    if (sl != (QSubscrList *)0) {
+        *stats = sl->stats;
+
+        // count the current subscribers of the signal
+#ifdef QF_MAX_SUBSCR
+        stats->nSubscr = sl->nSubscr;
+#else
+        QPSet set = sl->set;
+        uint8_t n = 0U;
+        // NOTE: the loop is bounded by QF_MAX_ACTIVE
+        for (; QPSet_notEmpty(&set); ++n) {
+            QPSet_remove(&set, QPSet_findMax(&set));
+        }
+        stats->nSubscr = n;
+#endif // def QF_MAX_SUBSCR
+
+        if (reset) {
+            QPubStats_reset_(&sl->stats);
+        }
+    }
+    else { // sparse storage without a slot for the signal, see NOTE6
+        QPubStats_reset_(stats); // publishes not counted
+    }
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @private @memberof QPubStats
+static void QPubStats_reset_(QPubStats * const me) {
+    me->nPub    = 0U;
+    me->nDeliv  = 0U;
+    me->nDrop   = 0U;
+    me->time    = 0U;
+    me->nSubscr = 0U;
+}
+#endif // def QF_PS_STATS
+
+#ifndef QF_MAX_SUBSCR
+
+//............................................................................
+//! @private @memberof QActive
+static uint_fast8_t QActive_multicast_(
     QPSet * const subscrSet,
     QEvt const * const e,
-    void const * const sender)
+    void const * const sender,
+    uint_fast8_t const ceiling)
 {
 #ifndef Q_SPY
     Q_UNUSED_PAR(sender);
@@ -158,8 +923,14 @@ static void QActive_multicast_(
 
     QF_CRIT_EXIT();
 
+    // lock the scheduler up to AO's prio (unless already locked there)
+    bool const lock = (p > ceiling);
     QF_SCHED_STAT_
-    QF_SCHED_LOCK_(p); // lock the scheduler up to AO's prio
+    if (lock) {
+        QF_SCHED_LOCK_(p);
+    }
+
+    uint_fast8_t nDeliv = 0U; // # delivered events
 
     // NOTE: the following loop does not need the fixed loop bound check
     // because the local subscriber set 'subscrSet' can hold at most
@@ -169,6 +940,7 @@ static void QActive_multicast_(
 
         // QACTIVE_POST() asserts internally if the queue overflows
         QACTIVE_POST(a, e, sender);
+        ++nDeliv;
 
         QPSet_remove(subscrSet, p); // remove the handled subscriber
         if (QPSet_isEmpty(subscrSet)) {  // no more subscribers?
@@ -188,14 +960,80 @@ static void QActive_multicast_(
         QF_CRIT_EXIT();
     }
 
-    QF_SCHED_UNLOCK_(); // unlock the scheduler
+    if (lock) {
+        QF_SCHED_UNLOCK_(); // unlock the scheduler
+    }
+
+    return nDeliv;
+}
+
+#endif // ndef QF_MAX_SUBSCR
+
+#ifdef QACTIVE_SUBSCR_INDEX
+//............................................................................
+//! @private @memberof QActive
+static void QActive_indexAdd_(QActive * const me,
+    QSignal const sig)
+{
+    // NOTE: must be called inside a critical section
+    uint_fast8_t const n = me->nSubscrSig;
+
+    // the AO must not subscribe to more signals than the index can hold
+    Q_ASSERT_INCRIT(910, n < QACTIVE_SUBSCR_INDEX);
+
+    me->subscrSig[n] = sig;
+    me->nSubscrSig = (uint8_t)(n + 1U);
 }
 
+//............................................................................
+//! @private @memberof QActive
+static void QActive_indexRemove_(QActive * const me,
+    QSignal const sig)
+{
+    // NOTE: must be called inside a critical section
+    uint_fast8_t const n = (uint_fast8_t)me->nSubscrSig - 1U;
+    uint_fast8_t i = 0U;
+    for (; me->subscrSig[i] != sig; ++i) { // find the signal
+        // the signal must be in the index
+        Q_ASSERT_INCRIT(1010, i < n);
+    }
+    me->subscrSig[i] = me->subscrSig[n]; // the order does not matter
+    me->nSubscrSig = (uint8_t)n;
+}
+#endif // def QACTIVE_SUBSCR_INDEX
+
 //............................................................................
 //! @protected @memberof QActive
 void QActive_subscribe(QActive const * const me,
     enum_t const sig)
 {
+    QActive_subscribe_(me, sig, (QEvtPred)0, (void *)0);
+}
+
+#ifdef QF_MAX_SUBSCR
+//............................................................................
+//! @protected @memberof QActive
+void QActive_subscribeFiltered(QActive const * const me,
+    enum_t const sig,
+    QEvtPred const filter,
+    void * const ctx)
+{
+    QActive_subscribe_(me, sig, filter, ctx);
+}
+#endif // def QF_MAX_SUBSCR
+
+//............................................................................
+//! @private @memberof QActive
+static void QActive_subscribe_(QActive const * const me,
+    enum_t const sig,
+    QEvtPred const filter,
+    void * const ctx)
+{
+#ifndef QF_MAX_SUBSCR
+    Q_UNUSED_PAR(filter);
+    Q_UNUSED_PAR(ctx);
+#endif
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -219,10 +1057,82 @@ void QActive_subscribe(QActive const * const me,
         QS_OBJ_PRE(me);   // this active object
     QS_END_PRE()
 
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, true);
+#if (defined QF_MAX_SUBSCR) || (defined QACTIVE_SUBSCR_INDEX)
+    QActive * const a = QActive_registry_[p]; // non-const 'me'
+#endif
+
+#ifdef QF_PS_RETAIN
+    // deliver the retained event to a new subscriber before the subscriber
+    // becomes visible to the publishers, see NOTE5
+    QEvt const *held = (QEvt *)0; // the retained event delivered last
+    if (!QPSet_hasElement(&sl->set, p)) { // new subscription?
+        // NOTE: the loop is bounded by QF_MAX_ACTIVE and repeats only when
+        // a newer event has been retained while the previous one was posted
+        for (uint_fast8_t n = QF_MAX_ACTIVE; n > 0U; --n) {
+            QEvt const * const retained = sl->retained;
+            if ((retained == (QEvt *)0) || (retained == held)) {
+                break; // nothing (new) to deliver
+            }
+#if (QF_MAX_EPOOL > 0U)
+            if (retained->poolNum_ != 0U) { // is it a mutable event?
+                QEvt_refCtr_inc_(retained); // hold it, see NOTE5
+            }
+#endif
+            QF_CRIT_EXIT();
+
+#if (QF_MAX_EPOOL > 0U)
+            if (held != (QEvt *)0) { // holding the previous retained event?
+                QF_gc(held); // release the previous hold
+            }
+#endif
+            held = retained;
+
+            // post like QActive_publish_() does for the new subscription
+            // (the filter and the default overflow policy Q_SUBSCR_ASSERT)
+#ifdef QF_MAX_SUBSCR
+            QSubscr subscr[1];
+            subscr[0].ao     = a;
+            subscr[0].filter = filter;
+            subscr[0].ctx    = ctx;
+            subscr[0].policy = (uint8_t)Q_SUBSCR_ASSERT;
+            subscr[0].margin = 0U;
+            subscr[0].nDrop  = 0U;
+            (void)QActive_multicast_(subscr, 1U, retained, me, 0U);
+#else
+            QPSet subscrSet;
+            QPSet_setEmpty(&subscrSet);
+            QPSet_insert(&subscrSet, p);
+            (void)QActive_multicast_(&subscrSet, retained, me, 0U);
+#endif // def QF_MAX_SUBSCR
+
+            QF_CRIT_ENTRY();
+        }
+    }
+#endif // def QF_PS_RETAIN
+
+#ifdef QF_MAX_SUBSCR
+    // insert the AO (or update its filter) in the precomputed subscriber
+    // array for the signal
+    QSubscrList_insert_(sl, a, filter, ctx);
+#endif
+
+#ifdef QACTIVE_SUBSCR_INDEX
+    if (!QPSet_hasElement(&sl->set, p)) { // new subscription?
+        QActive_indexAdd_(a, (QSignal)sig);
+    }
+#endif
+
     // insert the AO's prio. into the subscriber set for the signal
-    QPSet_insert(&QActive_subscrList_[sig].set, p);
+    QPSet_insert(&sl->set, p);
 
     QF_CRIT_EXIT();
+
+#if (defined QF_PS_RETAIN) && (QF_MAX_EPOOL > 0U)
+    if (held != (QEvt *)0) { // holding the retained event?
+        QF_gc(held); // release the hold
+    }
+#endif
 }
 
 //............................................................................
@@ -253,8 +1163,22 @@ void QActive_unsubscribe(QActive const * const me,
         QS_OBJ_PRE(me);   // this active object
     QS_END_PRE()
 
-    // remove the AO's prio. from the subscriber set for the signal
-    QPSet_remove(&QActive_subscrList_[sig].set, p);
+    QSubscrList * const sl = QActive_subscrFind_((QSignal)sig, false);
+    if (sl != (QSubscrList *)0) { // any subscribers to the signal?
+#ifdef QF_MAX_SUBSCR
+        // remove the AO from the precomputed subscriber array for the signal
+        QSubscrList_remove_(sl, p);
+#endif
+
+#ifdef QACTIVE_SUBSCR_INDEX
+        if (QPSet_hasElement(&sl->set, p)) { // subscribed?
+            QActive_indexRemove_(QActive_registry_[p], (QSignal)sig);
+        }
+#endif
+
+        // remove the AO's prio. from the subscriber set for the signal
+        QPSet_remove(&sl->set, p);
+    }
 
     QF_CRIT_EXIT();
 }
@@ -273,24 +1197,88 @@ void QActive_unsubscribeAll(QActive const * const me) {
     // the subscriber AO must be registered (started)
     Q_REQUIRE_INCRIT(640, me == QActive_registry_[p]);
 
+#ifdef QACTIVE_SUBSCR_INDEX
+
+    QActive * const a = QActive_registry_[p]; // non-const 'me'
+
+    QF_CRIT_EXIT();
+
+    // remove this AO's prio. only from the signals it subscribed to
+    // NOTE: the following loop does not need the fixed loop bound check
+    // because every pass removes one signal from the AO's subscription
+    // index, which holds at most QACTIVE_SUBSCR_INDEX signals.
+    for (;;) {
+        QF_CRIT_ENTRY();
+
+        uint_fast8_t const n = a->nSubscrSig;
+        if (n == 0U) { // no more subscriptions?
+            QF_CRIT_EXIT();
+            break;
+        }
+        QSignal const sig = a->subscrSig[n - 1U];
+        a->nSubscrSig = (uint8_t)(n - 1U);
+
+        QSubscrList * const sl = QActive_subscrFind_(sig, false);
+
+        // the subscriber list of an indexed signal must exist
+        Q_ASSERT_INCRIT(680, sl != (QSubscrList *)0);
+
+#ifdef QF_MAX_SUBSCR
+        // remove the AO from the precomputed subscriber array
+        QSubscrList_remove_(sl, p);
+#endif
+        // remove the AO's prio. from the subscriber set for the signal
+        QPSet_remove(&sl->set, p);
+
+        QS_BEGIN_PRE(QS_QF_ACTIVE_UNSUBSCRIBE, p)
+            QS_TIME_PRE();    // timestamp
+            QS_SIG_PRE(sig);  // the signal of this event
+            QS_OBJ_PRE(me);   // this active object
+        QS_END_PRE()
+
+        QF_CRIT_EXIT();
+
+        QF_CRIT_EXIT_NOP(); // prevent merging critical sections
+    }
+
+#else // QACTIVE_SUBSCR_INDEX not defined
+
     QSignal const maxPubSig = QActive_maxPubSignal_;
 
     // the maximum of published signals must not overlap the reserved signals
     Q_REQUIRE_INCRIT(670, maxPubSig >= (QSignal)Q_USER_SIG);
 
+#ifdef QF_PS_SPARSE
+    // scan only the slots of the sparse subscriber table
+    uint_fast16_t const first = 0U;
+    uint_fast16_t const end   = (uint_fast16_t)QActive_subscrMask_ + 1U;
+#else
+    uint_fast16_t const first = (uint_fast16_t)Q_USER_SIG;
+    uint_fast16_t const end   = (uint_fast16_t)maxPubSig;
+#endif
+
     QF_CRIT_EXIT();
 
     // remove this AO's prio. from subscriber lists of all published signals
-    for (QSignal sig = Q_USER_SIG; sig < maxPubSig; ++sig) {
+    for (uint_fast16_t i = first; i < end; ++i) {
         QF_CRIT_ENTRY();
 
-        if (QPSet_hasElement(&QActive_subscrList_[sig].set, p)) {
+        QSubscrList * const sl = &QActive_subscrList_[i];
+        if (QPSet_hasElement(&sl->set, p)) {
+#ifdef QF_MAX_SUBSCR
+            // remove the AO from the precomputed subscriber array
+            QSubscrList_remove_(sl, p);
+#endif
             // remove the AO's prio. from the subscriber set for the signal
-            QPSet_remove(&QActive_subscrList_[sig].set, p);
+            QPSet_remove(&sl->set, p);
 
             QS_BEGIN_PRE(QS_QF_ACTIVE_UNSUBSCRIBE, p)
                 QS_TIME_PRE();    // timestamp
-                QS_SIG_PRE(sig);  // the signal of this event
+#ifdef QF_PS_SPARSE
+                QS_SIG_PRE(sl->sig); // the signal of this event
+#else
+                QS_SIG_PRE(i);    // the signal of this event
+#endif
                 QS_OBJ_PRE(me);   // this active object
             QS_END_PRE()
         }
@@ -298,4 +1286,297 @@ void QActive_unsubscribeAll(QActive const * const me) {
 
         QF_CRIT_EXIT_NOP(); // prevent merging critical sections
     }
+
+#endif // def QACTIVE_SUBSCR_INDEX
+
+#ifdef QF_MAX_SUBSCR_RANGE
+    QF_CRIT_ENTRY();
+
+    // remove all range subscriptions of this AO
+    for (uint_fast8_t i = QActive_nSubscrRange_; i > 0U; --i) {
+        if (QActive_subscrRange_[i - 1U].prio == p) {
+            QActive_rangeRemove_(i - 1U);
+        }
+    }
+
+    QF_CRIT_EXIT();
+#endif // def QF_MAX_SUBSCR_RANGE
+}
+
+#ifdef QF_MAX_SUBSCR_RANGE
+//............................................................................
+//! @protected @memberof QActive
+void QActive_subscribeRange(QActive const * const me,
+    enum_t const first,
+    enum_t const last)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    uint8_t const p = me->prio;
+
+    // the AO's prio. must be in range
+    Q_REQUIRE_INCRIT(1600, (0U < p) && (p <= QF_MAX_ACTIVE));
+
+    // the subscriber AO must be registered (started)
+    Q_REQUIRE_INCRIT(1610, me == QActive_registry_[p]);
+
+    // the range must not overlap reserved signals, must not be empty,
+    // and must be below the maximum of published signals
+    Q_REQUIRE_INCRIT(1620, (first >= Q_USER_SIG) && (first <= last)
+        && ((QSignal)last < QActive_maxPubSignal_));
+
+    uint_fast8_t const n = QActive_nSubscrRange_;
+    uint_fast8_t i = 0U;
+    for (; i < n; ++i) {
+        QSubscrRange const * const r = &QActive_subscrRange_[i];
+        if ((r->prio == p) && (r->first == (QSignal)first)
+            && (r->last == (QSignal)last))
+        {
+            break; // already subscribed to this range
+        }
+    }
+
+    if (i == n) { // new range subscription?
+        // the number of range subscriptions must not exceed the maximum
+        Q_REQUIRE_INCRIT(1630, n < QF_MAX_SUBSCR_RANGE);
+
+        QSubscrRange * const r = &QActive_subscrRange_[n];
+        r->first = (QSignal)first;
+        r->last  = (QSignal)last;
+        r->prio  = p;
+        QActive_nSubscrRange_ = (uint8_t)(n + 1U);
+
+        // extend the span of all subscribed ranges
+        if ((n == 0U) || (QActive_rangeSpan_.first > r->first)) {
+            QActive_rangeSpan_.first = r->first;
+        }
+        if ((n == 0U) || (QActive_rangeSpan_.last < r->last)) {
+            QActive_rangeSpan_.last = r->last;
+        }
+    }
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @protected @memberof QActive
+void QActive_unsubscribeRange(QActive const * const me,
+    enum_t const first,
+    enum_t const last)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    uint8_t const p = me->prio;
+
+    // the AO's prio. must be in range
+    Q_REQUIRE_INCRIT(1700, (0U < p) && (p <= QF_MAX_ACTIVE));
+
+    // the subscriber AO must be registered (started)
+    Q_REQUIRE_INCRIT(1710, me == QActive_registry_[p]);
+
+    for (uint_fast8_t i = 0U; i < QActive_nSubscrRange_; ++i) {
+        QSubscrRange const * const r = &QActive_subscrRange_[i];
+        if ((r->prio == p) && (r->first == (QSignal)first)
+            && (r->last == (QSignal)last))
+        {
+            QActive_rangeRemove_(i);
+            break;
+        }
+    }
+
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+bool QActive_rangeSubscr_(
+    QSignal const sig,
+    QPSet * const subscrSet)
+{
+    // NOTE: must be called inside a critical section, see NOTE8
+    bool found = false;
+    uint_fast8_t const n = QActive_nSubscrRange_;
+    if ((n != 0U) && (QActive_rangeSpan_.first <= sig)
+        && (sig <= QActive_rangeSpan_.last))
+    {
+        for (uint_fast8_t i = 0U; i < n; ++i) {
+            QSubscrRange const * const r = &QActive_subscrRange_[i];
+            if ((r->first <= sig) && (sig <= r->last)) {
+                QPSet_insert(subscrSet, r->prio);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+//............................................................................
+//! @static @private @memberof QActive
+static void QActive_rangeRemove_(uint_fast8_t const i) {
+    // NOTE: must be called inside a critical section
+
+    // the removed range subscription must exist
+    Q_REQUIRE_INCRIT(1810, i < QActive_nSubscrRange_);
+
+    uint_fast8_t const n = (uint_fast8_t)QActive_nSubscrRange_ - 1U;
+    QActive_subscrRange_[i] = QActive_subscrRange_[n]; // fill the gap
+    QActive_nSubscrRange_ = (uint8_t)n;
+
+    // recalculate the span of the remaining ranges
+    for (uint_fast8_t j = 0U; j < n; ++j) {
+        QSubscrRange const * const r = &QActive_subscrRange_[j];
+        if ((j == 0U) || (QActive_rangeSpan_.first > r->first)) {
+            QActive_rangeSpan_.first = r->first;
+        }
+        if ((j == 0U) || (QActive_rangeSpan_.last < r->last)) {
+            QActive_rangeSpan_.last = r->last;
+        }
+    }
+}
+
+#ifdef QF_MAX_SUBSCR
+//............................................................................
+//! @static @private @memberof QActive
+uint_fast8_t QActive_rangeMerge_(
+    QSubscr subscr[],
+    uint_fast8_t const nSubscr,
+    QPSet * const rangeSet)
+{
+    // NOTE: must be called inside a critical section
+    uint_fast8_t n = nSubscr;
+
+    // NOTE: the following loop does not need the fixed loop bound check
+    // because every pass removes one element from the 'rangeSet'
+    while (QPSet_notEmpty(rangeSet)) {
+        uint_fast8_t const p = QPSet_findMax(rangeSet);
+        QPSet_remove(rangeSet, p);
+
+        // find the place of the subscriber in the descending priority order
+        uint_fast8_t i = 0U;
+        while ((i < n) && (subscr[i].ao->prio > p)) {
+            ++i;
+        }
+        if ((i < n) && (subscr[i].ao->prio == p)) {
+            continue; // subscribed to the signal itself, see NOTE8
+        }
+
+        QActive * const a = QActive_registry_[p];
+
+        // the range subscriber must be registered (started)
+        Q_ASSERT_INCRIT(1910, a != (QActive *)0);
+
+        for (uint_fast8_t j = n; j > i; --j) { // make room for the new entry
+            subscr[j] = subscr[j - 1U];
+        }
+        subscr[i].ao     = a;
+        subscr[i].filter = (QEvtPred)0;
+        subscr[i].ctx    = (void *)0;
+        subscr[i].nDrop  = 0U;
+        subscr[i].margin = 0U;
+        subscr[i].policy = (uint8_t)Q_SUBSCR_ASSERT;
+        ++n;
+    }
+    return n;
 }
+#endif // def QF_MAX_SUBSCR
+
+#endif // def QF_MAX_SUBSCR_RANGE
+
+//============================================================================
+// NOTE1:
+// With QF_MAX_SUBSCR defined, every signal keeps a compact array of its
+// subscribers sorted by descending priority, which is updated only when
+// AOs subscribe or unsubscribe (rare). QActive_publish_() copies just the
+// (typically few) subscriber pointers inside the critical section it
+// enters anyway, so the multicast needs neither QPSet_findMax() nor any
+// further critical sections for the QActive_registry_[] lookups.
+//
+// NOTE2:
+// With QF_PS_SPARSE defined, QActive_subscrList_[] is an open-addressing
+// hash table of a power-of-2 number of slots keyed by the signal, so it
+// needs only as many slots as there are distinct subscribed signals (plus
+// some headroom) rather than one slot per signal. The hash is simply the
+// low bits of the signal, which maps the typically consecutive signals to
+// distinct slots, and collisions are resolved by linear probing. Slots are
+// claimed at the first subscription to a signal and are never released,
+// so the probe sequences cannot be broken by unsubscribing.
+//
+// NOTE3:
+// The subscription filters are evaluated in the context of the publisher,
+// outside any critical section, but before locking the scheduler, so they
+// cannot delay the higher-priority threads. The filters must not block and
+// must not modify the event. The scheduler is then locked only up to the
+// priority of the highest-priority subscriber that accepted the event,
+// so that all accepting subscribers receive the event atomically.
+//
+// NOTE4:
+// A failed QACTIVE_POST_X() recycles the event with QF_gc(), which would
+// free a mutable event held only by the publisher in the middle of the
+// multicast. Therefore the multicast holds one extra reference for the
+// best-effort subscribers (Q_SUBSCR_DROP and Q_SUBSCR_CONFLATE), which is
+// consumed by a failed post and released at the end otherwise. With
+// Q_SUBSCR_CONFLATE, an event that cannot be posted replaces the most
+// recently queued event of the same signal in the subscriber's queue, so
+// the subscriber eventually processes the latest value. This is possible
+// only with the native QP event queue (QEQueue) and not for SPSC queues.
+// Otherwise, or when no such event is queued, the event is dropped.
+//
+// NOTE5:
+// For the signals enabled with QActive_setRetain(), QActive_publish_()
+// keeps the last published event in the subscriber list. A mutable event
+// is kept through its reference counter, so it is recycled only after
+// the next event of the same signal replaces it (or the signal is no
+// longer retained) and all subscribers have processed it. A new subscriber
+// receives the retained event immediately from QActive_subscribe(), so it
+// does not need to wait for the next publish of a state-like signal.
+//
+// The retained event is posted (through the same multicast path as the
+// published events) before the new subscriber is added to the subscriber
+// list. An event published in the meantime is therefore not delivered
+// ahead of the retained one, but it replaces the retained event, which is
+// detected when QActive_subscribe() re-enters the critical section. The
+// newer retained event is then posted as well, so the last event received
+// by the subscriber is the last one published. QActive_subscribe() holds
+// the retained event until the end, so it cannot be recycled and mistaken
+// for a newer event allocated from the same memory.
+//
+// NOTE6:
+// With QF_PS_STATS defined, QActive_publish_() counts the publishes in
+// the critical section it enters anyway. The deliveries and the fan-out
+// time (measured with QF_onGetTime() around the multicast) are added in
+// one more short critical section per publish. For sparse storage, only
+// the signals with a slot in the table (i.e., the signals ever subscribed
+// or retained) are counted. The publishes of the other signals are not
+// counted at all (not even the deliveries to the range subscribers), and
+// QActive_getPubStats() reports zeros for them. Claiming a slot in the
+// publish path just to count such publishes would fill the table with
+// signals that nobody subscribes to.
+//
+// NOTE7:
+// QActive_publishN_() locks the scheduler once for the whole batch, up to
+// the highest priority in the union of the subscriber sets of all events
+// in the batch. The union is computed in a critical section, which must
+// end before the scheduler can be locked, so a thread of a higher priority
+// could add a subscriber of an even higher priority in between. Therefore
+// the union is computed again with the scheduler locked and, if the
+// ceiling has grown, the scheduler is re-locked up to the new ceiling.
+// Once the ceiling covers all subscribers, no subscriber of the batch can
+// run (or change the subscriptions) before it has received all its events
+// from the batch, and the individual multicasts skip their own scheduler
+// locking. The events are published in order, so every subscriber
+// receives its events in the same order as in the batch. (A subscriber
+// added during the delivery by a thread above the ceiling receives only
+// the rest of the batch, as it would with separate publishes.)
+//
+// NOTE8:
+// With QF_MAX_SUBSCR_RANGE defined, the range subscriptions are kept in
+// a short list of intervals (first..last) together with the span of all
+// of them. QActive_publish_() checks the list only for the signals within
+// the span, so the signals outside the span (and all signals when there
+// are no range subscriptions) cost one extra comparison. The ranges cover
+// also the signals that nobody subscribes to individually (including the
+// signals without a slot in the sparse storage). An AO subscribed to a
+// signal both individually and through a range gets the event only once,
+// with the filter and the overflow policy of the individual subscription.
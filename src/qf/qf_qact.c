@@ -65,7 +65,33 @@ void QActive_ctor(QActive * const me,
         &QHsm_getStateHandler_
     };
     me->super.vptr = &vtable; // hook vptr to QActive vtable
+
+#if (defined QACTIVE_LATENCY_BINS) || (defined QACTIVE_SUBSCR_INDEX)
+    QActive_ctorOpt_(me);
+#endif
+}
+
+#if (defined QACTIVE_LATENCY_BINS) || (defined QACTIVE_SUBSCR_INDEX)
+//............................................................................
+//! @private @memberof QActive
+void QActive_ctorOpt_(QActive * const me) {
+    // clear the optional members, which the AO might not have zeroed
+    // (e.g., an AO allocated on the heap or re-constructed)
+#ifdef QACTIVE_LATENCY_BINS
+    for (uint_fast8_t b = 0U; b < QACTIVE_LATENCY_BINS; ++b) {
+        me->latHist[b] = 0U;
+    }
+    me->latMax = 0U;
+#endif // def QACTIVE_LATENCY_BINS
+
+#ifdef QACTIVE_SUBSCR_INDEX
+    for (uint_fast8_t i = 0U; i < QACTIVE_SUBSCR_INDEX; ++i) {
+        me->subscrSig[i] = 0U;
+    }
+    me->nSubscrSig = 0U; // no subscriptions yet
+#endif // def QACTIVE_SUBSCR_INDEX
 }
+#endif // (defined QACTIVE_LATENCY_BINS) || (defined QACTIVE_SUBSCR_INDEX)
 
 //............................................................................
 //! @private @memberof QActive
@@ -62,9 +62,50 @@ void QEQueue_init(QEQueue * const me,
     }
     me->nFree    = (QEQueueCtr)(qLen + 1U); // +1 for frontEvt
     me->nMin     = me->nFree; // minimum so far
+#ifdef QF_EQUEUE_SPSC
+    me->spsc     = 0U; // regular (multiple-producer) queue
+#endif
+
+    QF_CRIT_EXIT();
+}
+
+#ifdef QF_EQUEUE_SPSC
+//............................................................................
+//! @public @memberof QEQueue
+void QEQueue_initSPSC(QEQueue * const me,
+    QEvtPtr * const qSto,
+    uint_fast16_t const qLen)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the SPSC ring buffer needs one empty slot to tell "full" from "empty"
+    Q_REQUIRE_INCRIT(20, (qSto != (QEvtPtr *)0) && (qLen >= 2U));
+
+#if (QF_EQUEUE_CTR_SIZE == 1U)
+    // the qLen paramter must not exceed the dynamic range of uint8_t
+    Q_REQUIRE_INCRIT(30, qLen < 0xFFU);
+#endif
+
+    // NOTE: frontEvt is NOT part of the SPSC ring buffer. It is used only
+    // when the SPSC queue serves as the event queue of an active object,
+    // in which case frontEvt is the indicator for the QP kernel/port that
+    // the queue has events (see QActive_post_() and QActive_get_()).
+    me->frontEvt.e = (QEvt *)0;
+    me->ring     = qSto;
+    me->end      = (QEQueueCtr)qLen;
+    me->head     = 0U; // producer index: for inserting events
+    me->tail     = 0U; // consumer index: for removing events
+    me->nFree    = (QEQueueCtr)(qLen - 1U); // NOT updated in SPSC mode
+    me->nMin     = me->nFree; // minimum so far (updated by the producer)
+    me->spsc     = 1U; // single-producer/single-consumer queue
+#ifdef QF_EQUEUE_SPSC_CHECK
+    me->producer = 0U; // the producer not known yet
+#endif
 
     QF_CRIT_EXIT();
 }
+#endif // def QF_EQUEUE_SPSC
 
 //............................................................................
 //! @public @memberof QEQueue
@@ -77,6 +118,40 @@ bool QEQueue_post(QEQueue * const me,
     Q_UNUSED_PAR(qsId);
 #endif
 
+#ifdef QF_EQUEUE_SPSC
+    if (me->spsc != 0U) { // single-producer/single-consumer queue?
+        bool wasEmpty; // not needed for a stand-alone queue
+        bool const status = QEQueue_pushSPSC_(me, e, margin, &wasEmpty);
+        Q_UNUSED_PAR(wasEmpty);
+#ifdef Q_SPY
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        if (status) { // event posted?
+            QS_BEGIN_PRE(QS_QF_EQUEUE_POST, qsId)
+                QS_TIME_PRE();        // timestamp
+                QS_SIG_PRE(e->sig);   // the signal of the event
+                QS_OBJ_PRE(me);       // this queue object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE(QEQueue_getFree(me)); // # free entries
+                QS_EQC_PRE(me->nMin); // min # free entries
+            QS_END_PRE()
+        }
+        else { // event cannot be posted
+            QS_BEGIN_PRE(QS_QF_EQUEUE_POST_ATTEMPT, qsId)
+                QS_TIME_PRE();        // timestamp
+                QS_SIG_PRE(e->sig);   // the signal of this event
+                QS_OBJ_PRE(me);       // this queue object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE(QEQueue_getFree(me)); // # free entries
+                QS_EQC_PRE(margin);   // margin requested
+            QS_END_PRE()
+        }
+        QS_CRIT_EXIT();
+#endif // def Q_SPY
+        return status;
+    }
+#endif // def QF_EQUEUE_SPSC
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -163,6 +238,11 @@ void QEQueue_postLIFO(QEQueue * const me,
     // event e to be posted must be valid
     Q_REQUIRE_INCRIT(200, e != (QEvt *)0);
 
+#ifdef QF_EQUEUE_SPSC
+    // LIFO posting would make the consumer a second producer
+    Q_REQUIRE_INCRIT(210, me->spsc == 0U);
+#endif
+
     QEQueueCtr nFree = me->nFree; // get member into temporary
 
     // must be able to LIFO-post the event
@@ -213,6 +293,27 @@ struct QEvt const * QEQueue_get(QEQueue * const me,
     Q_UNUSED_PAR(qsId);
 #endif
 
+#ifdef QF_EQUEUE_SPSC
+    if (me->spsc != 0U) { // single-producer/single-consumer queue?
+        QEvt const * const e = QEQueue_popSPSC_(me);
+#ifdef Q_SPY
+        if (e != (QEvt *)0) {
+            QS_CRIT_STAT
+            QS_CRIT_ENTRY();
+            QS_BEGIN_PRE(QS_QF_EQUEUE_GET, qsId)
+                QS_TIME_PRE();      // timestamp
+                QS_SIG_PRE(e->sig); // the signal of this event
+                QS_OBJ_PRE(me);     // this queue object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE(QEQueue_getFree(me)); // # free entries
+            QS_END_PRE()
+            QS_CRIT_EXIT();
+        }
+#endif // def Q_SPY
+        return e;
+    }
+#endif // def QF_EQUEUE_SPSC
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -275,6 +376,12 @@ uint16_t QEQueue_getUse(QEQueue const * const me) {
     // NOTE: this function does NOT apply critical section, so it can
     // be safely called from an already established critical section.
     uint16_t nUse = 0U;
+#ifdef QF_EQUEUE_SPSC
+    if (me->spsc != 0U) { // single-producer/single-consumer queue?
+        nUse = (uint16_t)((uint16_t)me->end - 1U - QEQueue_getFree(me));
+    }
+    else
+#endif // def QF_EQUEUE_SPSC
     if (me->frontEvt.e != (QEvt *)0) { // queue not empty?
         nUse = (uint16_t)((uint16_t)me->end + 1U - (uint16_t)me->nFree);
     }
@@ -285,6 +392,17 @@ uint16_t QEQueue_getUse(QEQueue const * const me) {
 uint16_t QEQueue_getFree(QEQueue const * const me) {
     // NOTE: this function does NOT apply critical section, so it can
     // be safely called from an already established critical section.
+#ifdef QF_EQUEUE_SPSC
+    if (me->spsc != 0U) { // single-producer/single-consumer queue?
+        QEQueueCtr const head = QF_SPSC_LOAD_ACQ_(me->head);
+        QEQueueCtr const tail = QF_SPSC_LOAD_ACQ_(me->tail);
+        // # used entries between the tail and the head (counter-clockwise)
+        uint16_t const nUse = (tail >= head)
+            ? (uint16_t)((uint16_t)tail - (uint16_t)head)
+            : (uint16_t)((uint16_t)tail + (uint16_t)me->end - (uint16_t)head);
+        return (uint16_t)((uint16_t)me->end - 1U - nUse);
+    }
+#endif // def QF_EQUEUE_SPSC
     return (uint16_t)me->nFree;
 }
 //............................................................................
@@ -299,5 +417,114 @@ uint16_t QEQueue_getMin(QEQueue const * const me) {
 bool QEQueue_isEmpty(QEQueue const * const me) {
     // NOTE: this function does NOT apply critical section, so it can
     // be safely called from an already established critical section.
+#ifdef QF_EQUEUE_SPSC
+    if (me->spsc != 0U) { // single-producer/single-consumer queue?
+        return QF_SPSC_LOAD_ACQ_(me->head) == QF_SPSC_LOAD_ACQ_(me->tail);
+    }
+#endif // def QF_EQUEUE_SPSC
     return me->frontEvt.e == (struct QEvt *)0;
 }
+
+#ifdef QF_EQUEUE_SPSC
+//............................................................................
+//! @private @memberof QEQueue
+bool QEQueue_pushSPSC_(QEQueue * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    bool * const wasEmpty)
+{
+    // NOTE: this function is called by the only producer of the queue and
+    // does NOT apply critical section (except for a shared mutable event).
+    // The producer owns the 'head' index and the consumer owns the 'tail'
+    // index. The ring entries are published with the release-store of
+    // 'head' and obtained with the acquire-load of 'head' in the consumer.
+
+    // the posted event must be valid
+    Q_REQUIRE_LOCAL(500, e != (QEvt *)0);
+
+#ifdef QF_EQUEUE_SPSC_CHECK
+    uintptr_t const producer = QF_EQUEUE_SPSC_PRODUCER_();
+    if (me->producer == 0U) { // the first post to this queue?
+        me->producer = producer; // latch the only allowed producer
+    }
+    // SPSC queue must not be posted to by more than one producer
+    Q_REQUIRE_LOCAL(510, me->producer == producer);
+#endif // def QF_EQUEUE_SPSC_CHECK
+
+    QEQueueCtr const head = me->head; // only the producer changes 'head'
+    QEQueueCtr nFree = (QEQueueCtr)QEQueue_getFree(me);
+
+    bool const status = ((margin == QF_NO_MARGIN)
+        || (nFree > (QEQueueCtr)margin));
+    *wasEmpty = false;
+    if (status) { // can post the event?
+
+        // the queue must have a free slot
+        Q_ASSERT_LOCAL(530, nFree != 0U);
+
+#if (QF_MAX_EPOOL > 0U)
+        if (e->poolNum_ != 0U) { // is it a mutable event?
+            if (e->refCtr_ == 0U) { // held only by this producer?
+                // NOTE: nobody else can access the event yet, so its
+                // reference counter can be incremented without crit.sect.
+                QEvt_refCtr_inc_(e);
+            }
+            else { // the event is shared, so it needs a critical section
+                QF_CRIT_STAT
+                QF_CRIT_ENTRY();
+                QEvt_refCtr_inc_(e); // increment the reference counter
+                QF_CRIT_EXIT();
+            }
+        }
+#endif // (QF_MAX_EPOOL > 0U)
+
+        --nFree; // one free entry just used up
+        if (me->nMin > nFree) { // is this the new minimum?
+            me->nMin = nFree; // update minimum so far (only the producer)
+        }
+
+        me->ring[head].e = e; // insert e into the buffer
+        QACTIVE_EQUEUE_STAMP_(me->ring[head]);
+        QF_SPSC_STORE_REL_(me->head, // advance head (counter-clockwise)
+            (head == 0U) ? (QEQueueCtr)(me->end - 1U) : (QEQueueCtr)(head - 1U));
+
+        // the consumer might block on the queue only when it took out all
+        // the events before the one just posted (see NOTE1)
+        QF_SPSC_FENCE_();
+        *wasEmpty = (QF_SPSC_LOAD_ACQ_(me->tail) == head);
+    }
+
+    return status;
+}
+
+//............................................................................
+//! @private @memberof QEQueue
+QEvt const * QEQueue_popSPSC_(QEQueue * const me) {
+    // NOTE: this function is called by the only consumer of the queue and
+    // does NOT apply critical section.
+
+    QEQueueCtr const tail = me->tail; // only the consumer changes 'tail'
+    QEvt const *e = (QEvt *)0; // assume that the queue is empty
+
+    if (QF_SPSC_LOAD_ACQ_(me->head) != tail) { // is the queue NOT empty?
+        e = me->ring[tail].e; // remove the event from the tail
+
+        // the event in the ring buffer must be valid
+        Q_ASSERT_LOCAL(650, e != (QEvt *)0);
+
+        QF_SPSC_STORE_REL_(me->tail, // advance tail (counter-clockwise)
+            (tail == 0U) ? (QEQueueCtr)(me->end - 1U) : (QEQueueCtr)(tail - 1U));
+    }
+    return e;
+}
+
+//============================================================================
+// NOTE1:
+// The SPSC producer stores the 'head' index and then loads the 'tail' index,
+// while the consumer stores the 'tail' index and then loads the 'head' index
+// (to find out whether the queue became empty). The full memory fence between
+// the store and the load on both sides guarantees that at least one side
+// observes the store of the other. Consequently, if the consumer found the
+// queue empty (and might block), the producer is guaranteed to see the
+// queue as empty before its post and to signal the consumer.
+#endif // def QF_EQUEUE_SPSC
@@ -59,4 +59,8 @@ void QMActive_ctor(QMActive * const me,
         &QMsm_getStateHandler_
     };
     me->super.super.vptr = &vtable; // hook vptr to QMActive vtable
+
+#if (defined QACTIVE_LATENCY_BINS) || (defined QACTIVE_SUBSCR_INDEX)
+    QActive_ctorOpt_(&me->super);
+#endif
 }
@@ -47,6 +47,13 @@
 // <i>Default: 0 (All supported)
 #define QP_API_VERSION 0
 
+// <o>Maximum state nesting depth (QHSM_MAX_NEST_DEPTH) <3-32>
+// <i>Maximum depth of state nesting in QHsm/QMsm state machines
+// <i>(including the top state) <3..32>. Every event dispatch reserves
+// <i>an entry path array of this many state pointers on the stack.
+// <i>Default: 6
+#define QHSM_MAX_NEST_DEPTH 6U
+
 //..........................................................................
 // <h>QF Framework (Active Objects)
 // <i>Active Object framework
@@ -97,6 +104,20 @@
 // <i>Default: 1 (255 events maximum in a queue)
 #define QF_EQUEUE_CTR_SIZE  1U
 
+// <c1>Enable single-producer/single-consumer event queues (QF_EQUEUE_SPSC)
+// <i>Lock-free QEQueue mode for queues with exactly one producer
+// <i>(see QEQueue_initSPSC() and QActive_setSPSC()).
+// <i>NOTE: requires atomic operations (GCC/Clang builtins by default).
+//#define QF_EQUEUE_SPSC
+// </c>
+
+// <c1>Detect a second producer of SPSC event queues (QF_EQUEUE_SPSC_CHECK)
+// <i>Debug aid, which asserts when an SPSC queue is posted to
+// <i>from more than one thread.
+// <i>NOTE: requires QF_EQUEUE_SPSC_PRODUCER_() from the QP port.
+//#define QF_EQUEUE_SPSC_CHECK
+// </c>
+
 // <o>Memory pool counter size (QF_MPOOL_CTR_SIZE)
 //   <1U=>1
 //   <2U=>2 (default)
@@ -124,6 +145,133 @@
 //#define QACTIVE_CAN_STOP
 // </c>
 
+// <c1>Enable event queueing latency histograms (QACTIVE_LATENCY_BINS)
+// <i>Number of log2-scale bins of the enqueue-to-dispatch latency
+// <i>histogram in each active object (see QActive_getLatency()).
+// <i>NOTE: requires the QF_onGetTime() callback and the native
+// <i>QP event queue (QEQueue) for active objects.
+//#define QACTIVE_LATENCY_BINS 16U
+// </c>
+
+// <c1>Enable precomputed subscriber arrays (QF_MAX_SUBSCR)
+// <i>Maximum # subscribers to any single published signal. Each signal
+// <i>keeps a priority-sorted array of its subscribers, which is updated
+// <i>at (un)subscribing and is iterated directly by QActive_publish_().
+// <i>Also enables the subscription filters (QActive_subscribeFiltered()).
+// <i>NOTE: increases the size of QSubscrList by QF_MAX_SUBSCR entries.
+//#define QF_MAX_SUBSCR 8U
+// </c>
+
+// <c1>Enable sparse subscription storage (QF_PS_SPARSE)
+// <i>The subscriber lists are kept in a hash table keyed by the signal,
+// <i>which needs only as many slots as there are subscribed signals
+// <i>(see QActive_psInitSparse(), which replaces QActive_psInit()).
+//#define QF_PS_SPARSE
+// </c>
+
+// <c1>Enable retained last-value events (QF_PS_RETAIN)
+// <i>The signals selected with QActive_setRetain() keep the last
+// <i>published event, which is posted to every new subscriber.
+//#define QF_PS_RETAIN
+// </c>
+
+// <c1>Enable publish-subscribe statistics (QF_PS_STATS)
+// <i>Per-signal counters of publishes, deliveries, drops and the
+// <i>cumulative fan-out time (see QActive_getPubStats()).
+// <i>NOTE: requires the QF_onGetTime() callback.
+// <i>NOTE: with QF_PS_SPARSE, only the signals with a slot in the table
+// <i>(ever subscribed or retained) are counted.
+//#define QF_PS_STATS
+// </c>
+
+// <c1>Enable QHsm superstate cache (QHSM_CACHE)
+// <i>QHsm state machines attached to a QHsmCache (see QHsm_setCache())
+// <i>look up the superstates and the nesting depths of their states in
+// <i>the cache instead of calling the state handlers with Q_EMPTY_SIG.
+// <i>NOTE: increases the size of every state machine by one pointer.
+//#define QHSM_CACHE
+// </c>
+
+// <c1>Enable state ancestry bitsets (QASM_ANCESTRY)
+// <i>Compact state indexes and ancestry bitsets (up to 32 states per
+// <i>class) turn the "is-in" state checks into single bit tests.
+// <i>QHsm: assigned at first use in the QHsmCache (needs QHSM_CACHE).
+// <i>QMsm: generated in QMState objects (see QMsm_isInState()).
+//#define QASM_ANCESTRY
+// </c>
+
+// <c1>Enable per-state dispatch profiling (QASM_PROFILE)
+// <i>Maximum # profiled state handlers (power of 2). QHsm and QMsm count
+// <i>the handled/unhandled events and transitions in every state and
+// <i>the cumulative time of the RTC steps (see QAsm_getProfile()).
+// <i>NOTE: requires the QF_onGetTime() callback (e.g., cycle counter).
+//#define QASM_PROFILE 64U
+// </c>
+
+// <c1>Enable QMsm signal maps (QMSM_SIG_MAP)
+// <i>QMState objects can carry a sparse map of the handled signals
+// <i>(generated from the model), so QMsm_dispatch_() skips the states
+// <i>that do not handle the signal and takes the unconditional
+// <i>transitions without calling the state handlers.
+// <i>NOTE: the legacy positional QMState initializers (without the map)
+// <i>remain valid, but trigger -Wmissing-field-initializers warnings.
+// <i>Regenerate them or use QMSTATE_INITIALIZER() (see qp.h).
+//#define QMSM_SIG_MAP
+// </c>
+
+// <c1>Enable range subscriptions (QF_MAX_SUBSCR_RANGE)
+// <i>Maximum # signal-range subscriptions in the system <1..255>
+// <i>(see QActive_subscribeRange()). The ranges are kept in a compact
+// <i>interval list, which QActive_publish_() checks only for the signals
+// <i>within the span of all subscribed ranges.
+//#define QF_MAX_SUBSCR_RANGE 8U
+// </c>
+
+// <c1>Enable per-AO subscription index (QACTIVE_SUBSCR_INDEX)
+// <i>Maximum # signals a single active object can subscribe to <1..255>.
+// <i>Each AO keeps the list of its subscribed signals, so that
+// <i>QActive_unsubscribeAll() touches only those signals.
+//#define QACTIVE_SUBSCR_INDEX 16U
+// </c>
+
+// <c1>Enable active object snapshots (QACTIVE_SNAPSHOT)
+// <i>Save the current state, an application data blob and the deferred
+// <i>events of an AO in a compact buffer (see QActive_snapshot()) and
+// <i>restore them in the top-most initial tran. (see QActive_restore()).
+// <i>NOTE: requires event pools (QF_MAX_EPOOL > 0).
+//#define QACTIVE_SNAPSHOT
+// </c>
+
+// <c1>Enable shared-memory event channels (QF_SHM)
+// <i>Channels between processes with a queue and a pool of events in
+// <i>POSIX shared memory (see QShm_create() and QShm_open()), which are
+// <i>delivered to an AO like locally posted events.
+// <i>NOTE: POSIX ports only (posix and posix-qv, see qshm.h).
+//#define QF_SHM
+// </c>
+
+// <c1>Enable publish-subscribe bridges between processes (QF_BRIDGE)
+// <i>Active objects that forward the published events to the bridge in
+// <i>a peer process over a UNIX-domain or loopback TCP socket and
+// <i>publish the events received from the peer (see qbridge.h).
+// <i>NOTE: POSIX ports only (posix and posix-qv).
+//#define QF_BRIDGE
+// </c>
+
+// <c1>Maximum # events in one bridge write (QBRIDGE_BATCH)
+// <i>The events waiting in the queue of a QBridge are sent to the peer
+// <i>in a single gather-write of up to QBRIDGE_BATCH events.
+// <i>Default: 16 (needs QF_BRIDGE)
+//#define QBRIDGE_BATCH 16U
+// </c>
+
+// <c1>Size of the bridge receive buffer (QBRIDGE_RX_SIZE)
+// <i>Receive buffer of a QBridge [bytes], which must fit the largest
+// <i>bridged event together with its frame header.
+// <i>Default: 1024 (needs QF_BRIDGE)
+//#define QBRIDGE_RX_SIZE 1024U
+// </c>
+
 // <c1>Enable context switch callback *without* QS (QF_ON_CONTEXT_SW)
 // <i>Context switch callback QF_onContextSw() when Q_SPY is undefined.
 //#ifndef Q_SPY
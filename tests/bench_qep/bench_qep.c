@@ -0,0 +1,647 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+// QEP event-dispatch microbenchmark (host, qep-only port), see NOTE1
+//============================================================================
+#include "qpc.h"       // QP/C public interface
+#include "safe_std.h"  // portable "safe" <stdio.h>/<string.h> facilities
+
+#include <stdlib.h>    // for exit(), strtoul()
+#include <time.h>      // for timespec_get() (C11)
+
+#define MAX_DEPTH    6U        // maximum nesting depth of the leaf states
+#define N_DISPATCH   200000UL  // default # dispatches per measurement
+#define N_RUNS       5U        // default # runs (the minimum is reported)
+
+enum BenchSignals {
+    LEAF_SIG = Q_USER_SIG, // internal tran. in the leaf state
+    ROOT_SIG,              // internal tran. in the root state (S1)
+    IGNORED_SIG,           // not handled in any state
+    SIMPLE_SIG,            // tran. between the sibling leaf states
+    COMPLEX_SIG,           // tran. between the leaves of disjoint branches
+    MAX_SIG
+};
+
+static QEvt const l_evt[MAX_SIG - LEAF_SIG] = {
+    QEVT_INITIALIZER(LEAF_SIG),
+    QEVT_INITIALIZER(ROOT_SIG),
+    QEVT_INITIALIZER(IGNORED_SIG),
+    QEVT_INITIALIZER(SIMPLE_SIG),
+    QEVT_INITIALIZER(COMPLEX_SIG)
+};
+
+static char const * const l_caseName[MAX_SIG - LEAF_SIG] = {
+    "leaf", "root", "ignored", "simple", "complex"
+};
+
+//============================================================================
+// QHsm variant of the benchmark state machine
+//
+// top
+//  +-S1         (root of the main branch)
+//  |  +-...
+//  |     +-Sd   (leaf, initial state)
+//  |     +-Ld   (sibling of Sd)
+//  +-T1         (root of the disjoint branch)
+//     +-...
+//        +-Td   (leaf)
+//
+// The same state handlers serve all depths d=1..MAX_DEPTH, where
+// only the states Sd, Ld and Td handle the events (see me->depth).
+
+typedef struct {
+    QHsm super;      // inherited QHsm
+    uint8_t depth;   // nesting depth of the leaf states
+    uint32_t count;  // # executed actions (keeps the actions observable)
+} BenchHsm;
+
+static QState BenchHsm_initial(BenchHsm * const me, void const * const par);
+static QState BenchHsm_S_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k);
+static QState BenchHsm_L_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k);
+static QState BenchHsm_T_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k);
+
+// the state handlers of the level k_ delegate to the generic handlers
+#define BENCH_HSM_LEVEL(k_) \
+static QState BenchHsm_S##k_(BenchHsm * const me, QEvt const * const e) { \
+    return BenchHsm_S_(me, e, k_##U); \
+} \
+static QState BenchHsm_L##k_(BenchHsm * const me, QEvt const * const e) { \
+    return BenchHsm_L_(me, e, k_##U); \
+} \
+static QState BenchHsm_T##k_(BenchHsm * const me, QEvt const * const e) { \
+    return BenchHsm_T_(me, e, k_##U); \
+}
+
+BENCH_HSM_LEVEL(1)
+BENCH_HSM_LEVEL(2)
+BENCH_HSM_LEVEL(3)
+BENCH_HSM_LEVEL(4)
+BENCH_HSM_LEVEL(5)
+BENCH_HSM_LEVEL(6)
+
+// the states of each branch indexed by the level (0 is the top state)
+static QStateHandler const l_hsmS[MAX_DEPTH + 1U] = {
+    Q_STATE_CAST(&QHsm_top),
+    Q_STATE_CAST(&BenchHsm_S1), Q_STATE_CAST(&BenchHsm_S2),
+    Q_STATE_CAST(&BenchHsm_S3), Q_STATE_CAST(&BenchHsm_S4),
+    Q_STATE_CAST(&BenchHsm_S5), Q_STATE_CAST(&BenchHsm_S6)
+};
+static QStateHandler const l_hsmL[MAX_DEPTH + 1U] = {
+    Q_STATE_CAST(&QHsm_top),
+    Q_STATE_CAST(&BenchHsm_L1), Q_STATE_CAST(&BenchHsm_L2),
+    Q_STATE_CAST(&BenchHsm_L3), Q_STATE_CAST(&BenchHsm_L4),
+    Q_STATE_CAST(&BenchHsm_L5), Q_STATE_CAST(&BenchHsm_L6)
+};
+static QStateHandler const l_hsmT[MAX_DEPTH + 1U] = {
+    Q_STATE_CAST(&QHsm_top),
+    Q_STATE_CAST(&BenchHsm_T1), Q_STATE_CAST(&BenchHsm_T2),
+    Q_STATE_CAST(&BenchHsm_T3), Q_STATE_CAST(&BenchHsm_T4),
+    Q_STATE_CAST(&BenchHsm_T5), Q_STATE_CAST(&BenchHsm_T6)
+};
+
+//............................................................................
+static QState BenchHsm_initial(BenchHsm * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(l_hsmS[me->depth]);
+}
+//............................................................................
+static QState BenchHsm_S_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k)
+{
+    QState status;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: // intentionally fall through
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status = Q_HANDLED();
+            break;
+        }
+        case LEAF_SIG: {
+            if (k == me->depth) {
+                ++me->count;
+                status = Q_HANDLED();
+            }
+            else {
+                status = Q_SUPER(l_hsmS[k - 1U]);
+            }
+            break;
+        }
+        case ROOT_SIG: {
+            if (k == 1U) {
+                ++me->count;
+                status = Q_HANDLED();
+            }
+            else {
+                status = Q_SUPER(l_hsmS[k - 1U]);
+            }
+            break;
+        }
+        case SIMPLE_SIG: {
+            status = (k == me->depth)
+                     ? Q_TRAN(l_hsmL[k])
+                     : Q_SUPER(l_hsmS[k - 1U]);
+            break;
+        }
+        case COMPLEX_SIG: {
+            status = (k == me->depth)
+                     ? Q_TRAN(l_hsmT[k])
+                     : Q_SUPER(l_hsmS[k - 1U]);
+            break;
+        }
+        default: {
+            status = Q_SUPER(l_hsmS[k - 1U]);
+            break;
+        }
+    }
+    return status;
+}
+//............................................................................
+static QState BenchHsm_L_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k)
+{
+    QState status;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: // intentionally fall through
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status = Q_HANDLED();
+            break;
+        }
+        case SIMPLE_SIG: {
+            status = Q_TRAN(l_hsmS[k]);
+            break;
+        }
+        default: {
+            status = Q_SUPER(l_hsmS[k - 1U]);
+            break;
+        }
+    }
+    return status;
+}
+//............................................................................
+static QState BenchHsm_T_(BenchHsm * const me, QEvt const * const e,
+                          uint_fast8_t const k)
+{
+    QState status;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: // intentionally fall through
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status = Q_HANDLED();
+            break;
+        }
+        case COMPLEX_SIG: {
+            status = (k == me->depth)
+                     ? Q_TRAN(l_hsmS[k])
+                     : Q_SUPER(l_hsmT[k - 1U]);
+            break;
+        }
+        default: {
+            status = Q_SUPER(l_hsmT[k - 1U]);
+            break;
+        }
+    }
+    return status;
+}
+
+//============================================================================
+// QMsm variant of the benchmark state machine (the same hierarchy)
+
+typedef struct {
+    QMsm super;      // inherited QMsm
+    uint8_t depth;   // nesting depth of the leaf states
+    uint32_t count;  // # executed actions (keeps the actions observable)
+} BenchMsm;
+
+// tran-action table with room for the longest tran. in the benchmark
+typedef struct {
+    QMState const *target;
+    QActionHandler act[(2U * MAX_DEPTH) + 1U];
+} BenchTatbl;
+
+enum BenchTrans { TRAN_INIT, TRAN_S_L, TRAN_L_S, TRAN_S_T, TRAN_T_S,
+                  TRAN_MAX };
+
+// the tran-action tables are built for the benchmarked depth at run-time
+static BenchTatbl l_msmTran[TRAN_MAX];
+
+static QState BenchMsm_initial(BenchMsm * const me, void const * const par);
+static QState BenchMsm_S_(BenchMsm * const me, QEvt const * const e,
+                          uint_fast8_t const k);
+static QState BenchMsm_L_(BenchMsm * const me, QEvt const * const e);
+static QState BenchMsm_T_(BenchMsm * const me, QEvt const * const e,
+                          uint_fast8_t const k);
+
+// the optional QMState members (no signal maps, no ancestry bitsets)
+#ifdef QMSM_SIG_MAP
+#define BENCH_MSM_SIG_MAP  , QM_SIG_MAP_NULL
+#else
+#define BENCH_MSM_SIG_MAP
+#endif
+#ifdef QASM_ANCESTRY
+#define BENCH_MSM_ANCESTRY , 0U, 0xFFU
+#else
+#define BENCH_MSM_ANCESTRY
+#endif
+
+// the state handlers of the level k_ delegate to the generic handlers
+#define BENCH_MSM_STATE(name_, super_, handler_) \
+static QState BenchMsm_##name_(BenchMsm * const me, QEvt const * const e) { \
+    return handler_; \
+} \
+static QMState const BenchMsm_##name_##_s; \
+static QState BenchMsm_##name_##_e(BenchMsm * const me) { \
+    ++me->count; \
+    return QM_ENTRY(&BenchMsm_##name_##_s); \
+} \
+static QState BenchMsm_##name_##_x(BenchMsm * const me) { \
+    ++me->count; \
+    return QM_EXIT(&BenchMsm_##name_##_s); \
+} \
+static QMState const BenchMsm_##name_##_s = { \
+    super_, \
+    Q_STATE_CAST(&BenchMsm_##name_), \
+    Q_ACTION_CAST(&BenchMsm_##name_##_e), \
+    Q_ACTION_CAST(&BenchMsm_##name_##_x), \
+    Q_ACTION_CAST(0) \
+    BENCH_MSM_SIG_MAP \
+    BENCH_MSM_ANCESTRY \
+};
+
+#define BENCH_MSM_LEVEL(k_, superS_, superT_) \
+BENCH_MSM_STATE(S##k_, superS_, BenchMsm_S_(me, e, k_##U)) \
+BENCH_MSM_STATE(L##k_, superS_, BenchMsm_L_(me, e)) \
+BENCH_MSM_STATE(T##k_, superT_, BenchMsm_T_(me, e, k_##U))
+
+BENCH_MSM_LEVEL(1, QM_STATE_NULL,   QM_STATE_NULL)
+BENCH_MSM_LEVEL(2, &BenchMsm_S1_s, &BenchMsm_T1_s)
+BENCH_MSM_LEVEL(3, &BenchMsm_S2_s, &BenchMsm_T2_s)
+BENCH_MSM_LEVEL(4, &BenchMsm_S3_s, &BenchMsm_T3_s)
+BENCH_MSM_LEVEL(5, &BenchMsm_S4_s, &BenchMsm_T4_s)
+BENCH_MSM_LEVEL(6, &BenchMsm_S5_s, &BenchMsm_T5_s)
+
+// the states of each branch indexed by the level (0 is not used)
+static QMState const * const l_msmS[MAX_DEPTH + 1U] = {
+    QM_STATE_NULL,
+    &BenchMsm_S1_s, &BenchMsm_S2_s, &BenchMsm_S3_s,
+    &BenchMsm_S4_s, &BenchMsm_S5_s, &BenchMsm_S6_s
+};
+static QMState const * const l_msmL[MAX_DEPTH + 1U] = {
+    QM_STATE_NULL,
+    &BenchMsm_L1_s, &BenchMsm_L2_s, &BenchMsm_L3_s,
+    &BenchMsm_L4_s, &BenchMsm_L5_s, &BenchMsm_L6_s
+};
+static QMState const * const l_msmT[MAX_DEPTH + 1U] = {
+    QM_STATE_NULL,
+    &BenchMsm_T1_s, &BenchMsm_T2_s, &BenchMsm_T3_s,
+    &BenchMsm_T4_s, &BenchMsm_T5_s, &BenchMsm_T6_s
+};
+
+#define TATBL(tran_) ((QMTranActTable const *)&l_msmTran[(tran_)])
+
+//............................................................................
+static QState BenchMsm_initial(BenchMsm * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return QM_TRAN_INIT(TATBL(TRAN_INIT));
+}
+//............................................................................
+static QState BenchMsm_S_(BenchMsm * const me, QEvt const * const e,
+                          uint_fast8_t const k)
+{
+    QState status;
+    switch (e->sig) {
+        case LEAF_SIG: {
+            if (k == me->depth) {
+                ++me->count;
+                status = QM_HANDLED();
+            }
+            else {
+                status = QM_SUPER();
+            }
+            break;
+        }
+        case ROOT_SIG: {
+            if (k == 1U) {
+                ++me->count;
+                status = QM_HANDLED();
+            }
+            else {
+                status = QM_SUPER();
+            }
+            break;
+        }
+        case SIMPLE_SIG: {
+            status = (k == me->depth)
+                     ? QM_TRAN(TATBL(TRAN_S_L))
+                     : QM_SUPER();
+            break;
+        }
+        case COMPLEX_SIG: {
+            status = (k == me->depth)
+                     ? QM_TRAN(TATBL(TRAN_S_T))
+                     : QM_SUPER();
+            break;
+        }
+        default: {
+            status = QM_SUPER();
+            break;
+        }
+    }
+    return status;
+}
+//............................................................................
+static QState BenchMsm_L_(BenchMsm * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case SIMPLE_SIG: {
+            status = QM_TRAN(TATBL(TRAN_L_S));
+            break;
+        }
+        default: {
+            status = QM_SUPER();
+            break;
+        }
+    }
+    return status;
+}
+//............................................................................
+static QState BenchMsm_T_(BenchMsm * const me, QEvt const * const e,
+                          uint_fast8_t const k)
+{
+    QState status;
+    switch (e->sig) {
+        case COMPLEX_SIG: {
+            status = (k == me->depth)
+                     ? QM_TRAN(TATBL(TRAN_T_S))
+                     : QM_SUPER();
+            break;
+        }
+        default: {
+            status = QM_SUPER();
+            break;
+        }
+    }
+    return status;
+}
+//............................................................................
+// build the tran-action tables (as generated by QM) for the given depth
+static void BenchMsm_buildTrans(uint_fast8_t const d) {
+    // action handlers of the states indexed by the level
+    static QActionHandler const entryS[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_S1_e), Q_ACTION_CAST(&BenchMsm_S2_e),
+        Q_ACTION_CAST(&BenchMsm_S3_e), Q_ACTION_CAST(&BenchMsm_S4_e),
+        Q_ACTION_CAST(&BenchMsm_S5_e), Q_ACTION_CAST(&BenchMsm_S6_e)
+    };
+    static QActionHandler const exitS[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_S1_x), Q_ACTION_CAST(&BenchMsm_S2_x),
+        Q_ACTION_CAST(&BenchMsm_S3_x), Q_ACTION_CAST(&BenchMsm_S4_x),
+        Q_ACTION_CAST(&BenchMsm_S5_x), Q_ACTION_CAST(&BenchMsm_S6_x)
+    };
+    static QActionHandler const entryL[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_L1_e), Q_ACTION_CAST(&BenchMsm_L2_e),
+        Q_ACTION_CAST(&BenchMsm_L3_e), Q_ACTION_CAST(&BenchMsm_L4_e),
+        Q_ACTION_CAST(&BenchMsm_L5_e), Q_ACTION_CAST(&BenchMsm_L6_e)
+    };
+    static QActionHandler const exitL[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_L1_x), Q_ACTION_CAST(&BenchMsm_L2_x),
+        Q_ACTION_CAST(&BenchMsm_L3_x), Q_ACTION_CAST(&BenchMsm_L4_x),
+        Q_ACTION_CAST(&BenchMsm_L5_x), Q_ACTION_CAST(&BenchMsm_L6_x)
+    };
+    static QActionHandler const entryT[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_T1_e), Q_ACTION_CAST(&BenchMsm_T2_e),
+        Q_ACTION_CAST(&BenchMsm_T3_e), Q_ACTION_CAST(&BenchMsm_T4_e),
+        Q_ACTION_CAST(&BenchMsm_T5_e), Q_ACTION_CAST(&BenchMsm_T6_e)
+    };
+    static QActionHandler const exitT[MAX_DEPTH + 1U] = {
+        Q_ACTION_CAST(0),
+        Q_ACTION_CAST(&BenchMsm_T1_x), Q_ACTION_CAST(&BenchMsm_T2_x),
+        Q_ACTION_CAST(&BenchMsm_T3_x), Q_ACTION_CAST(&BenchMsm_T4_x),
+        Q_ACTION_CAST(&BenchMsm_T5_x), Q_ACTION_CAST(&BenchMsm_T6_x)
+    };
+    uint_fast8_t i;
+    uint_fast8_t k;
+
+    (void)memset(l_msmTran, 0, sizeof(l_msmTran));
+
+    // top-most initial tran.: enter S1..Sd
+    l_msmTran[TRAN_INIT].target = l_msmS[d];
+    for (k = 1U; k <= d; ++k) {
+        l_msmTran[TRAN_INIT].act[k - 1U] = entryS[k];
+    }
+
+    // simple tran. between the sibling leaves (the same superstate)
+    l_msmTran[TRAN_S_L].target = l_msmL[d];
+    l_msmTran[TRAN_S_L].act[0] = exitS[d];
+    l_msmTran[TRAN_S_L].act[1] = entryL[d];
+    l_msmTran[TRAN_L_S].target = l_msmS[d];
+    l_msmTran[TRAN_L_S].act[0] = exitL[d];
+    l_msmTran[TRAN_L_S].act[1] = entryS[d];
+
+    // complex tran. between the disjoint branches (LCA is the top)
+    l_msmTran[TRAN_S_T].target = l_msmT[d];
+    l_msmTran[TRAN_T_S].target = l_msmS[d];
+    i = 0U;
+    for (k = d; k > 0U; --k) {
+        l_msmTran[TRAN_S_T].act[i] = exitS[k];
+        l_msmTran[TRAN_T_S].act[i] = exitT[k];
+        ++i;
+    }
+    for (k = 1U; k <= d; ++k) {
+        l_msmTran[TRAN_S_T].act[i] = entryT[k];
+        l_msmTran[TRAN_T_S].act[i] = entryS[k];
+        ++i;
+    }
+}
+
+//============================================================================
+// measurement
+
+static double Bench_now(void) { // monotonic enough for the short runs
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+//............................................................................
+// the minimum over the runs of the average time per dispatch [ns]
+static double Bench_measure(QAsm * const sm, QEvt const * const e,
+                            unsigned long const n, unsigned const runs)
+{
+    double best = 0.0;
+    for (unsigned r = 0U; r < runs; ++r) {
+        double const t0 = Bench_now();
+        for (unsigned long i = 0UL; i < n; ++i) {
+            QASM_DISPATCH(sm, e, 0U);
+        }
+        double const ns = (Bench_now() - t0) / (double)n;
+        if ((r == 0U) || (ns < best)) {
+            best = ns;
+        }
+    }
+    return best;
+}
+//............................................................................
+static void Bench_report(char const * const engine, uint_fast8_t const d,
+                         double const * const ns)
+{
+    PRINTF_S("%-5s %5u", engine, (unsigned)d);
+    for (uint_fast8_t c = 0U; c < (MAX_SIG - LEAF_SIG); ++c) {
+        PRINTF_S(" %9.1f", ns[c]);
+    }
+    PRINTF_S("%s\n", "");
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    // the # dispatches is rounded to even, so that every tran. case
+    // ends in the initial leaf state (each dispatch toggles the leaf)
+    unsigned long n = (argc > 1) ? strtoul(argv[1], (char **)0, 10)
+                                 : N_DISPATCH;
+    unsigned runs = (argc > 2) ? (unsigned)strtoul(argv[2], (char **)0, 10)
+                               : N_RUNS;
+    n = (n < 2UL) ? 2UL : (n & ~1UL);
+    runs = (runs < 1U) ? 1U : runs;
+
+    PRINTF_S("QEP dispatch benchmark: %lu dispatches, min of %u runs, "
+             "[ns/dispatch]\n", n, runs);
+    PRINTF_S("config:%s%s%s%s%s\n",
+#ifdef Q_UNSAFE
+        " Q_UNSAFE",
+#else
+        " (assertions)",
+#endif
+#ifdef QHSM_CACHE
+        " QHSM_CACHE",
+#else
+        "",
+#endif
+#ifdef QMSM_SIG_MAP
+        " QMSM_SIG_MAP",
+#else
+        "",
+#endif
+#ifdef QASM_ANCESTRY
+        " QASM_ANCESTRY",
+#else
+        "",
+#endif
+#ifdef QASM_PROFILE
+        " QASM_PROFILE"
+#else
+        ""
+#endif
+    );
+    PRINTF_S("%-5s %5s", "SM", "depth");
+    for (uint_fast8_t c = 0U; c < (MAX_SIG - LEAF_SIG); ++c) {
+        PRINTF_S(" %9s", l_caseName[c]);
+    }
+    PRINTF_S("%s\n", "");
+
+    double ns[MAX_SIG - LEAF_SIG];
+    uint32_t count = 0U;
+
+#ifdef QHSM_CACHE
+    // the superstate and transition caches shared by all BenchHsm objects
+    static QHsmSuper superSto[64];
+    static QHsmTran tranSto[32];
+    static QHsmCache cache;
+    QHsmCache_ctor(&cache, superSto, Q_DIM(superSto));
+    QHsmCache_initTran(&cache, tranSto, Q_DIM(tranSto));
+#endif
+
+    for (uint_fast8_t d = 1U; d <= MAX_DEPTH; ++d) {
+        static BenchHsm hsm;
+        QHsm_ctor(&hsm.super, Q_STATE_CAST(&BenchHsm_initial));
+#ifdef QHSM_CACHE
+        QHsm_setCache(&hsm.super, &cache);
+#endif
+        hsm.depth = (uint8_t)d;
+        hsm.count = 0U;
+        QASM_INIT(&hsm.super.super, (void *)0, 0U);
+        for (uint_fast8_t c = 0U; c < (MAX_SIG - LEAF_SIG); ++c) {
+            ns[c] = Bench_measure(&hsm.super.super, &l_evt[c], n, runs);
+        }
+        Bench_report("QHsm", d, ns);
+        count += hsm.count;
+    }
+
+    for (uint_fast8_t d = 1U; d <= MAX_DEPTH; ++d) {
+        static BenchMsm msm;
+        BenchMsm_buildTrans(d);
+        QMsm_ctor(&msm.super, Q_STATE_CAST(&BenchMsm_initial));
+        msm.depth = (uint8_t)d;
+        msm.count = 0U;
+        QASM_INIT(&msm.super.super, (void *)0, 0U);
+        for (uint_fast8_t c = 0U; c < (MAX_SIG - LEAF_SIG); ++c) {
+            ns[c] = Bench_measure(&msm.super.super, &l_evt[c], n, runs);
+        }
+        Bench_report("QMsm", d, ns);
+        count += msm.count;
+    }
+
+    // the actions must have been executed (also defeats the optimizer)
+    return (count != 0U) ? 0 : -1;
+}
+
+#ifdef QASM_PROFILE
+//............................................................................
+uint32_t QF_onGetTime(void) { // time source for the dispatch profiles
+    return (uint32_t)Bench_now();
+}
+#endif // def QASM_PROFILE
+
+//............................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    FPRINTF_S(stderr, "ERROR in %s:%d\n", module, (int)id);
+    exit(-1);
+}
+
+//============================================================================
+// NOTE1:
+// The benchmark measures the QEP engines alone (QHsm in qep_hsm.c and
+// QMsm in qep_msm.c), built with the "qep-only" port, without the QF
+// framework. For every nesting depth of the leaf states (1..MAX_DEPTH)
+// it dispatches the same immutable event repeatedly and reports the
+// minimum over several runs of the average time per dispatch, which is
+// the most repeatable statistic on a host with other activity:
+// - leaf:    internal tran. handled in the leaf state
+// - root:    internal tran. handled in the outermost state (bubbling)
+// - ignored: the event is not handled in any state
+// - simple:  tran. between two sibling leaves (exit 1, enter 1 state)
+// - complex: tran. between the leaves of two branches, whose LCA is the
+//            top state (exit d, enter d states)
+// The entry/exit actions only count, so the times are dominated by the
+// engine itself. Compare the reports of different builds (e.g., with and
+// without Q_UNSAFE or the optional QEP features) on the same machine.
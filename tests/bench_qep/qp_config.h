@@ -0,0 +1,39 @@
+//============================================================================
+// QP/C configuration for the QEP dispatch benchmark (qep-only port)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QP_CONFIG_H_
+#define QP_CONFIG_H_
+
+// no QF framework in the qep-only port (only the QEP engines are built)
+#define QF_MAX_EPOOL         0U
+#define QF_MAX_TICK_RATE     0U
+
+// the benchmark nests the leaf states up to 6 levels below the top
+#define QHSM_MAX_NEST_DEPTH  8U
+
+#endif // QP_CONFIG_H_
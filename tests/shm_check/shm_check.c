@@ -0,0 +1,144 @@
+//============================================================================
+// QP/C Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+// QShm shared-memory channel check (host, posix-qv port), see NOTE1
+//============================================================================
+#include "qpc.h"       // QP/C public interface
+#include "safe_std.h"  // portable "safe" <stdio.h>/<string.h> facilities
+
+#include <stdlib.h>    // for exit()
+#include <unistd.h>    // for getpid()
+
+#define N_EVTS  4U     // # event blocks in the checked channels
+#define Q_LEN   10U    // length of the event queue in the checked channels
+
+//............................................................................
+// check one channel configuration, return the # failures
+static unsigned check_channel(uint_fast16_t const evtSize) {
+    char name[32];
+    SNPRINTF_S(name, sizeof(name), "/qshm_check_%d", (int)getpid());
+
+    unsigned nFail = 0U;
+    QShm owner;
+    QShm peer;
+    if (!QShm_create(&owner, name, Q_LEN, evtSize, N_EVTS)) {
+        FPRINTF_S(stderr, "evtSize=%u: create failed\n", (unsigned)evtSize);
+        return 1U;
+    }
+    if (!QShm_open(&peer, name)) {
+        FPRINTF_S(stderr, "evtSize=%u: open failed\n", (unsigned)evtSize);
+        (void)QShm_close(&owner);
+        return 1U;
+    }
+
+    // all event blocks must be allocatable, distinct and inside the
+    // mapping of the segment (the free list is built by QShm_create())
+    uint8_t const * const begin = (uint8_t const *)peer.seg;
+    uint8_t const * const end   = begin + peer.size;
+    QEvt *evt[N_EVTS];
+    for (uint_fast16_t i = 0U; i < N_EVTS; ++i) {
+        evt[i] = QShm_newX_(&peer, evtSize, 0U, Q_USER_SIG);
+        uint8_t const * const p = (uint8_t const *)evt[i];
+        if ((evt[i] == (QEvt *)0) || (p < begin) || ((p + evtSize) > end)) {
+            FPRINTF_S(stderr, "evtSize=%u: bad block %u\n",
+                      (unsigned)evtSize, (unsigned)i);
+            ++nFail;
+            evt[i] = (QEvt *)0;
+        }
+        for (uint_fast16_t k = 0U; k < i; ++k) {
+            if ((evt[i] != (QEvt *)0) && (evt[k] == evt[i])) {
+                FPRINTF_S(stderr, "evtSize=%u: block %u allocated twice\n",
+                          (unsigned)evtSize, (unsigned)i);
+                ++nFail;
+            }
+        }
+    }
+    if (QShm_newX_(&peer, evtSize, 0U, Q_USER_SIG) != (QEvt *)0) {
+        FPRINTF_S(stderr, "evtSize=%u: more than %u blocks\n",
+                  (unsigned)evtSize, (unsigned)N_EVTS);
+        ++nFail;
+    }
+
+    for (uint_fast16_t i = 0U; i < N_EVTS; ++i) {
+        if (evt[i] != (QEvt *)0) {
+            QF_gc(evt[i]); // recycled through QF_EPOOL_EXT_PUT_()
+        }
+    }
+    if (QShm_getPoolMin(&peer) != 0U) {
+        FPRINTF_S(stderr, "evtSize=%u: pool minimum not updated\n",
+                  (unsigned)evtSize);
+        ++nFail;
+    }
+
+    (void)QShm_close(&peer);
+    if (!QShm_close(&owner)) {
+        FPRINTF_S(stderr, "evtSize=%u: close failed\n", (unsigned)evtSize);
+        ++nFail;
+    }
+    return nFail;
+}
+
+//............................................................................
+int main(void) {
+    QF_init(); // initialize the framework (critical sections)
+
+    // the event sizes below and above the size of the segment header
+    // together with the event queue (the offset of the first block)
+    static uint_fast16_t const evtSizes[] = { 16U, 64U, 256U, 1024U };
+    unsigned nFail = 0U;
+    for (uint_fast8_t i = 0U; i < Q_DIM(evtSizes); ++i) {
+        nFail += check_channel(evtSizes[i]);
+    }
+
+    PRINTF_S("QShm check: %s\n", (nFail == 0U) ? "PASSED" : "FAILED");
+    return (nFail == 0U) ? 0 : 1;
+}
+
+//============================================================================
+// QF callbacks...
+void QF_onStartup(void) {
+}
+//............................................................................
+void QF_onCleanup(void) {
+}
+//............................................................................
+void QF_onClockTick(void) {
+}
+
+//............................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    FPRINTF_S(stderr, "ERROR in %s:%d\n", module, (int)id);
+    exit(-1);
+}
+
+//============================================================================
+// NOTE1:
+// The check creates a channel and opens it again as the peer in the same
+// process, so the pool of shared events can be exercised without a second
+// process. The event sizes cover the blocks that are larger than the part
+// of the segment before the first block (the header and the event queue),
+// which used to break the construction of the free list.